@@ -50,19 +50,30 @@ include(D:/08YYYXXX/QXlsx-master/QXlsx/QXlsx.pri)
 
 # Input
 HEADERS += \
+           besselfunctions.h \
            chartsetting1.h \
            chartsetting2.h \
            chartwidget.h \
            chartwindow.h \
+           curveinterpolator.h \
            datacalculate.h \
            datacolumndialog.h \
            dataimportdialog.h \
+           datareduction.h \
            datasinglesheet.h \
+           dualnumber.h \
            fittingdatadialog.h \
            fittingpage.h \
            fittingparameterchart.h \
+           fittingworkspace.h \
+           gausskronrod.h \
+           globaloptimizer.h \
+           laplaceinterpolator.h \
+           laplaceinversion.h \
+           lmoptimizer.h \
            modelmanager.h \
            modelparameter.h \
+           modelparams.h \
            modelselect.h \
            modelsolver01-06.h \
            mousezoom.h \
@@ -76,6 +87,7 @@ HEADERS += \
            plottingdialog2.h \
            plottingdialog3.h \
            plottingdialog4.h \
+           populationoptimizer.h \
            pressurederivativecalculator.h \
            pressurederivativecalculator1.h \
            settingswidget.h \
@@ -118,19 +130,28 @@ FORMS += \
          wt_projectwidget.ui
 
 SOURCES += \
+           besselfunctions.cpp \
            chartsetting1.cpp \
            chartsetting2.cpp \
            chartwidget.cpp \
            chartwindow.cpp \
+           curveinterpolator.cpp \
            datacalculate.cpp \
            datacolumndialog.cpp \
            dataimportdialog.cpp \
+           datareduction.cpp \
            datasinglesheet.cpp \
            fittingdatadialog.cpp \
            fittingpage.cpp \
            fittingparameterchart.cpp \
+           fittingworkspace.cpp \
+           globaloptimizer.cpp \
+           laplaceinterpolator.cpp \
+           laplaceinversion.cpp \
+           lmoptimizer.cpp \
            modelmanager.cpp \
            modelparameter.cpp \
+           modelparams.cpp \
            modelselect.cpp \
            modelsolver01-06.cpp \
            mousezoom.cpp \
@@ -145,6 +166,7 @@ SOURCES += \
            plottingdialog2.cpp \
            plottingdialog3.cpp \
            plottingdialog4.cpp \
+           populationoptimizer.cpp \
            pressurederivativecalculator.cpp \
            pressurederivativecalculator1.cpp \
            settingswidget.cpp \
@@ -0,0 +1,592 @@
+/*
+ * besselfunctions.cpp
+ * 文件作用: 试井模型专用 Bessel 函数库实现
+ * 功能描述:
+ * 1. |z| <= 2 时使用幂级数 (A&S 9.6.10 - 9.6.13) 计算 I0、I1、K0、K1。
+ * 2. 2 < |z| <= 25 时使用 Steed 连分式 (Thompson-Barnett 方法) 计算 K0、K1，
+ *    再由 I1/I0 连分式与 Wronskian 关系 I0*K1 + I1*K0 = 1/z 得到 I0、I1。
+ * 3. |z| > 25 时使用 Hankel 渐近展开 (I 函数在靠近虚轴时保留 exp(-2z) 次要项)。
+ * 4. 所有结果均为指数缩放形式，避免大自变量时上溢/下溢。
+ * 5. 实数自变量使用分段 Chebyshev 级数 (Clenshaw 递推求值)。系数由 50 位精度的 mpmath 在
+ *    Chebyshev-Gauss 节点上离线计算，截断至 |c_k| < 2e-18 * max|c|；与 boost 对比的最大相对误差约 1e-15。
+ *    mpmath (Python) 只是重新生成系数时的开发依赖，构建与运行均不需要，仓库中也不包含。
+ * 6. 批量接口在 AVX2 下以 4 路向量同时执行 Clenshaw 递推；小自变量的 K 函数及指数/对数部分逐个计算。
+ *    向量函数带 target("avx2") 属性单独编译，首次调用时用 __builtin_cpu_supports 检测 CPU，不支持时走标量路径。
+ */
+
+#include "besselfunctions.h"
+
+#include <cmath>
+#include <limits>
+
+// AVX2 路径：编译器已启用 AVX2 (-mavx2、/arch:AVX2) 时直接使用；GCC/Clang 的 x86 目标未启用时，
+// 向量函数单独按 AVX2 编译，运行时检测 CPU 支持后才调用 (默认构建即可使用，不要求额外编译选项)
+#if defined(__AVX2__)
+#define WT_BESSEL_AVX2 1
+#define WT_BESSEL_AVX2_TARGET
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define WT_BESSEL_AVX2 1
+#define WT_BESSEL_AVX2_DISPATCH 1
+#define WT_BESSEL_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+#if defined(WT_BESSEL_AVX2)
+#include <immintrin.h>
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+const double kEulerGamma = 0.57721566490153286061;
+const double kEps = 1e-16;
+const double kAsymptoticRadius = 25.0;
+
+// ---- 实数自变量 Chebyshev 系数: f = c0/2 + sum(c_k * T_k(t)) ----
+// I0(x)，x 属于 [0, 2]，t = x^2/2 - 1
+const double kI0Small[] = {
+    3.20584561361592657e+00, 6.38809625651177049e-01, 3.68548596943617593e-02,
+    9.82878127251479933e-04, 1.49836542089272928e-05, 1.47384490084238481e-07,
+    1.01147979006748264e-09, 5.11499790201127948e-12, 1.98428062268056199e-14,
+    6.09051650605895544e-17
+};
+// i0e(x)，x 属于 (2, 8]，t = (x - 5)/3
+const double kI0Mid[] = {
+    4.05309163392612359e-01, -7.53011328591056267e-02, 2.10090765480883956e-02,
+    -6.50921521770236617e-03, 2.08412959412550324e-03, -6.63237694109267031e-04,
+    2.04478870993031920e-04, -6.00849969199607092e-05, 1.66685447741122756e-05,
+    -4.34486590695866034e-06, 1.06234087832029178e-06, -2.43688049437113520e-07,
+    5.25090050291472926e-08, -1.06479844237078174e-08, 2.03641939957062057e-09,
+    -3.68140710734679477e-10, 6.30506972276145393e-11, -1.02530585982202530e-11,
+    1.58643963625676455e-12, -2.34030894231131314e-13, 3.29781689056941371e-14,
+    -4.44691602849819660e-15, 5.74775590016996155e-16, -7.13226611507442709e-17,
+    8.50916607798878030e-18, -9.77411590028822516e-19
+};
+// sqrt(x) * i0e(x)，x > 8，t = 16/x - 1
+const double kI0Large[] = {
+    8.04490411014108786e-01, 3.36911647825569429e-03, 6.88975834691682454e-05,
+    2.89137052083475665e-06, 2.04891858946906384e-07, 2.26666899049817804e-08,
+    3.39623202570838651e-09, 4.94060238822497006e-10, 1.18891471078464390e-11,
+    -3.14991652796324165e-11, -1.32158118404477133e-11, -1.79417853150680615e-12,
+    7.18012445138366601e-13, 3.85277838274214259e-13, 1.54008621752140996e-14,
+    -4.15056934728722224e-14, -9.55484669882830731e-15, 3.81168066935262240e-15,
+    1.77256013305652631e-15, -3.42548561967721900e-16, -2.82762398051658365e-16,
+    3.46122286769746122e-17, 4.46562142029675975e-17, -4.83050448594418188e-18,
+    -7.23318048787475380e-18
+};
+// I1(x) / x，x 属于 [0, 2]，t = x^2/2 - 1
+const double kI1Small[] = {
+    1.28351799398237487e+00, 1.47539320149193409e-01, 5.89874268002078816e-03,
+    1.19881371746387077e-04, 1.47391651190931279e-06, 1.21380749687409224e-08,
+    7.16110669279927911e-11, 3.17487931131012018e-13, 1.09629983487730759e-15,
+    3.03150212209335526e-18
+};
+// i1e(x)，x 属于 (2, 8]，t = (x - 5)/3
+const double kI1Mid[] = {
+    3.39570836427507683e-01, -4.08170154447159497e-02, 5.47150482238746311e-03,
+    -3.71998674305439459e-05, -4.35011696170696462e-04, 2.51098738494546982e-04,
+    -1.03870105605610689e-04, 3.63359517117256122e-05, -1.12837795313803812e-05,
+    3.17717726279552503e-06, -8.20787985420401380e-07, 1.96082598181792852e-07,
+    -4.35741628393799605e-08, 9.05062296202025203e-09, -1.76421679682222308e-09,
+    3.23885612334266302e-10, -5.61783918184342651e-11, 9.23249404283714933e-12,
+    -1.44131862996250830e-12, 2.14246111745095655e-13, -3.03887703859155678e-14,
+    4.12117120514030409e-15, -5.35339302617959421e-16, 6.67225855718117860e-17,
+    -7.99158891222135848e-18, 9.21177884706753340e-19
+};
+// sqrt(x) * i1e(x)，x > 8，t = 16/x - 1
+const double kI1Large[] = {
+    7.78576235018280105e-01, -9.76109749136146870e-03, -1.10588938762623713e-04,
+    -3.88256480887769059e-06, -2.51223623787020884e-07, -2.63146884688951959e-08,
+    -3.83538038596423700e-09, -5.58974346219658378e-10, -1.89749581235054126e-11,
+    3.25260358301548844e-11, 1.41258074366137819e-11, 2.03562854414708956e-12,
+    -7.19855177624590836e-13, -4.08355111109219740e-13, -2.10154184277266430e-14,
+    4.27244001671195105e-14, 1.04202769841288021e-14, -3.81440307243700754e-15,
+    -1.88035477551078251e-15, 3.30820231092092852e-16, 2.96262899764595008e-16,
+    -3.20952592199342376e-17, -4.65030536848935863e-17, 4.41434832307170765e-18,
+    7.51729631084210521e-18
+};
+// K0(x) + ln(x/2) * I0(x)，x 属于 (0, 2]，t = x^2/2 - 1
+const double kK0Small[] = {
+    -5.35327393233902771e-01, 3.44289899924628495e-01, 3.59799365153615006e-02,
+    1.26461541144692598e-03, 2.28621210311945192e-05, 2.53479107902614939e-07,
+    1.90451637722020905e-09, 1.03496952576336253e-11, 4.25981614279108258e-14,
+    1.37446543588075084e-16
+};
+// sqrt(x) * k0e(x)，x > 2，t = 4/x - 1
+const double kK0Large[] = {
+    2.44030308206595548e+00, -3.14481013119645020e-02, 1.56988388573005332e-03,
+    -1.28495495816278017e-04, 1.39498137188765002e-05, -1.83175552271911953e-06,
+    2.76681363944501486e-07, -4.66048989768794783e-08, 8.57403401741422527e-09,
+    -1.69753450938906142e-09, 3.57739728140032832e-10, -7.95748924447739648e-11,
+    1.85594911495492645e-11, -4.51459788337451925e-12, 1.14034058820734414e-12,
+    -2.98009692314817842e-13, 8.03289077506837463e-14, -2.22751332674629647e-14,
+    6.34007647627664606e-15, -1.84859337792090710e-15, 5.51205599940433350e-16,
+    -1.67823112575490059e-16, 5.21039177764355432e-17, -1.64758059398426321e-17,
+    5.30043377117733540e-18
+};
+// x * (K1(x) - ln(x/2) * I1(x))，x 属于 (0, 2]，t = x^2/2 - 1
+const double kK1Small[] = {
+    1.52530022733894777e+00, -3.53155960776544875e-01, -1.22611180822657151e-01,
+    -6.97572385963986415e-03, -1.73028895751305199e-04, -2.43340614156596836e-06,
+    -2.21338763073472599e-08, -1.41148839263352781e-10, -6.66690169419932948e-13,
+    -2.42744985051936596e-15, -7.02386347938628815e-18
+};
+// sqrt(x) * k1e(x)，x > 2，t = 4/x - 1
+const double kK1Large[] = {
+    2.72062619048444265e+00, 1.03923736576817236e-01, -2.85781685962277921e-03,
+    1.95215518471351620e-04, -1.93619797416608301e-05, 2.40648494783721699e-06,
+    -3.50196060308781256e-07, 5.74108412545004947e-08, -1.03457624656780968e-08,
+    2.01504975519703466e-09, -4.19035475934192542e-10, 9.21831518760531460e-11,
+    -2.12996783842779092e-11, 5.13963967348234321e-12, -1.28917396094982285e-12,
+    3.34841966605224312e-13, -8.97670518201014629e-14, 2.47715442421959878e-14,
+    -7.01983708921476847e-15, 2.03870316623986097e-15, -6.05704727064301766e-16,
+    1.83809357524304548e-16, -5.68946284919364841e-17, 1.79405104788635718e-17,
+    -5.75674448207330252e-18
+};
+
+// Clenshaw 递推
+inline double chebyshev(const double* c, int n, double t)
+{
+    double t2 = 2.0 * t;
+    double b1 = 0.0, b2 = 0.0;
+    for (int k = n - 1; k >= 1; --k) {
+        double b0 = t2 * b1 - b2 + c[k];
+        b2 = b1;
+        b1 = b0;
+    }
+    return t * b1 - b2 + 0.5 * c[0];
+}
+
+template<int N>
+inline double chebyshev(const double (&c)[N], double t)
+{
+    return chebyshev(c, N, t);
+}
+
+#if defined(WT_BESSEL_AVX2)
+// 4 路向量 Clenshaw 递推
+WT_BESSEL_AVX2_TARGET inline __m256d chebyshev4(const double* c, int n, __m256d t)
+{
+    __m256d t2 = _mm256_add_pd(t, t);
+    __m256d b1 = _mm256_setzero_pd();
+    __m256d b2 = _mm256_setzero_pd();
+    for (int k = n - 1; k >= 1; --k) {
+        __m256d b0 = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(t2, b1), b2), _mm256_set1_pd(c[k]));
+        b2 = b1;
+        b1 = b0;
+    }
+    return _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(t, b1), b2), _mm256_set1_pd(0.5 * c[0]));
+}
+
+// I 函数中、大自变量段 (x > 2)，按区间选择两段级数，只在有车道落入该区间时才计算；
+// 小自变量车道 (x <= 2) 由调用者逐个修正
+WT_BESSEL_AVX2_TARGET inline __m256d iLarge4(const double* cMid, int nMid, const double* cLarge, int nLarge, __m256d ax)
+{
+    __m256d mid = _mm256_cmp_pd(ax, _mm256_set1_pd(8.0), _CMP_LE_OQ);
+    int mask = _mm256_movemask_pd(mid);
+    __m256d rm = _mm256_setzero_pd(), rl = _mm256_setzero_pd();
+    if (mask != 0) {
+        __m256d t = _mm256_div_pd(_mm256_sub_pd(ax, _mm256_set1_pd(5.0)), _mm256_set1_pd(3.0));
+        rm = chebyshev4(cMid, nMid, t);
+    }
+    if (mask != 0xF) {
+        __m256d t = _mm256_sub_pd(_mm256_div_pd(_mm256_set1_pd(16.0), ax), _mm256_set1_pd(1.0));
+        rl = _mm256_div_pd(chebyshev4(cLarge, nLarge, t), _mm256_sqrt_pd(ax));
+    }
+    return _mm256_blendv_pd(rl, rm, mid);
+}
+
+// K 函数大自变量段 (x > 2)；小自变量车道由调用者逐个修正
+WT_BESSEL_AVX2_TARGET inline __m256d kLarge4(const double* c, int n, __m256d x)
+{
+    __m256d t = _mm256_sub_pd(_mm256_div_pd(_mm256_set1_pd(4.0), x), _mm256_set1_pd(1.0));
+    return _mm256_div_pd(chebyshev4(c, n, t), _mm256_sqrt_pd(x));
+}
+
+WT_BESSEL_AVX2_TARGET inline int smallMask(__m256d x)
+{
+    return _mm256_movemask_pd(_mm256_cmp_pd(x, _mm256_set1_pd(2.0), _CMP_LE_OQ));
+}
+
+// CPU 是否支持 AVX2 (编译期已启用时恒为 true)
+inline bool hasAvx2()
+{
+#if defined(WT_BESSEL_AVX2_DISPATCH)
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return true;
+#endif
+}
+#endif
+}
+
+void BesselFunctions::k01e(Complex z, Complex& k0e, Complex& k1e)
+{
+    Complex i0e, i1e;
+    all01e(z, k0e, k1e, i0e, i1e);
+}
+
+void BesselFunctions::i01e(Complex z, Complex& i0e, Complex& i1e)
+{
+    Complex k0e, k1e;
+    all01e(z, k0e, k1e, i0e, i1e);
+}
+
+// 根据自变量模长选择计算区域
+void BesselFunctions::all01e(Complex z, Complex& k0e, Complex& k1e, Complex& i0e, Complex& i1e)
+{
+    double az = std::abs(z);
+    if (az <= 2.0) {
+        seriesSmall(z, k0e, k1e, i0e, i1e);
+    } else if (az <= kAsymptoticRadius) {
+        continuedFraction(z, k0e, k1e, i0e, i1e);
+    } else {
+        asymptotic(z, k0e, k1e, i0e, i1e);
+    }
+}
+
+// 幂级数: I0, I1 直接求和；K0, K1 使用含对数项的级数 (|z| <= 2 时无明显相消)
+void BesselFunctions::seriesSmall(Complex z, Complex& k0e, Complex& k1e, Complex& i0e, Complex& i1e)
+{
+    Complex q = 0.25 * z * z;        // (z/2)^2
+    Complex logHalf = std::log(0.5 * z);
+
+    // term0 = q^k / (k!)^2，term1 = q^k / (k! (k+1)!)
+    Complex term0(1.0, 0.0), term1(1.0, 0.0);
+    Complex sumI0 = term0, sumI1 = term1;
+    Complex sumK0(0.0, 0.0);
+    double harmonic = 0.0;           // H_k
+    Complex sumK1 = term1 * (2.0 * (-kEulerGamma) + 1.0); // k=0: psi(1)+psi(2)
+
+    for (int k = 1; k < 60; ++k) {
+        term0 *= q / double(k * k);
+        term1 *= q / double(k * (k + 1));
+        harmonic += 1.0 / k;
+        double psiSum = 2.0 * (-kEulerGamma + harmonic) + 1.0 / (k + 1); // psi(k+1) + psi(k+2)
+
+        sumI0 += term0;
+        sumI1 += term1;
+        sumK0 += term0 * harmonic;
+        sumK1 += term1 * psiSum;
+
+        if (std::abs(term0) < kEps * std::abs(sumI0) && std::abs(term1) < kEps * std::abs(sumI1)) break;
+    }
+
+    Complex I0 = sumI0;
+    Complex I1 = 0.5 * z * sumI1;
+    Complex K0 = -(logHalf + kEulerGamma) * I0 + sumK0;
+    Complex K1 = 1.0 / z + logHalf * I1 - 0.25 * z * sumK1;
+
+    Complex ez = std::exp(z);
+    Complex emz = std::exp(-z);
+    k0e = K0 * ez;
+    k1e = K1 * ez;
+    i0e = I0 * emz;
+    i1e = I1 * emz;
+}
+
+// 连分式: Steed 算法 (CF2) 求缩放 K0, K1；CF1 求 f = I1/I0，再由 Wronskian 关系求 I0
+void BesselFunctions::continuedFraction(Complex z, Complex& k0e, Complex& k1e, Complex& i0e, Complex& i1e)
+{
+    const double tiny = 1e-300;
+
+    // ---- CF2 (nu = 0) ----
+    Complex b = 2.0 * (1.0 + z);
+    Complex d = 1.0 / b;
+    Complex h = d, delh = d;
+    Complex q1(0.0, 0.0), q2(1.0, 0.0);
+    double a1 = 0.25;
+    Complex qq(a1, 0.0), c(a1, 0.0);
+    double a = -a1;
+    Complex s = 1.0 + qq * delh;
+    for (int i = 1; i < 1000; ++i) {
+        a -= 2 * i;
+        c = -a * c / (i + 1.0);
+        Complex qnew = (q1 - b * q2) / a;
+        q1 = q2;
+        q2 = qnew;
+        qq += c * qnew;
+        b += 2.0;
+        d = 1.0 / (b + a * d);
+        delh = (b * d - 1.0) * delh;
+        h += delh;
+        Complex dels = qq * delh;
+        s += dels;
+        if (std::abs(dels) < kEps * std::abs(s)) break;
+    }
+    h = a1 * h;
+    k0e = std::sqrt(M_PI / (2.0 * z)) / s;
+    k1e = k0e * (z + 0.5 - h) / z;
+
+    // ---- CF1 (修正 Lentz 算法): f = I0'/I0 = I1/I0 ----
+    Complex xi2 = 2.0 / z;
+    Complex f(tiny, 0.0);
+    Complex bb(0.0, 0.0), dd(0.0, 0.0), cc = f;
+    for (int i = 1; i < 10000; ++i) {
+        bb += xi2;
+        dd = bb + dd;
+        if (std::abs(dd) < tiny) dd = tiny;
+        dd = 1.0 / dd;
+        cc = bb + 1.0 / cc;
+        if (std::abs(cc) < tiny) cc = tiny;
+        Complex del = cc * dd;
+        f *= del;
+        if (std::abs(del - 1.0) < kEps) break;
+    }
+
+    // Wronskian: I0*K1 + I1*K0 = 1/z  =>  I0 = 1 / (z * (K1 + f*K0))
+    i0e = 1.0 / (z * (k1e + f * k0e));
+    i1e = f * i0e;
+}
+
+// Hankel 渐近展开 (I 函数在靠近虚轴时补充 exp(-2z) 量级的次要项)
+void BesselFunctions::asymptotic(Complex z, Complex& k0e, Complex& k1e, Complex& i0e, Complex& i1e)
+{
+    Complex inv8z = 1.0 / (8.0 * z);
+    Complex sumK0(1.0, 0.0), sumK1(1.0, 0.0), sumI0(1.0, 0.0), sumI1(1.0, 0.0);
+    Complex t0(1.0, 0.0), t1(1.0, 0.0);
+    double last0 = 1.0, last1 = 1.0;
+
+    for (int k = 1; k < 60; ++k) {
+        double odd = double((2 * k - 1) * (2 * k - 1));
+        Complex n0 = t0 * ((0.0 - odd) / k) * inv8z;  // mu = 4*0^2 = 0
+        Complex n1 = t1 * ((4.0 - odd) / k) * inv8z;  // mu = 4*1^2 = 4
+        double a0 = std::abs(n0), a1 = std::abs(n1);
+        // 渐近级数发散前截断
+        if (a0 > last0 || a1 > last1) break;
+        t0 = n0;
+        t1 = n1;
+        last0 = a0;
+        last1 = a1;
+        double sign = (k % 2 == 0) ? 1.0 : -1.0;
+        sumK0 += t0;
+        sumK1 += t1;
+        sumI0 += sign * t0;
+        sumI1 += sign * t1;
+        if (a0 < kEps * std::abs(sumK0) && a1 < kEps * std::abs(sumK1)) break;
+    }
+
+    Complex kPre = std::sqrt(M_PI / (2.0 * z));
+    Complex iPre = 1.0 / std::sqrt(2.0 * M_PI * z);
+    k0e = kPre * sumK0;
+    k1e = kPre * sumK1;
+    i0e = iPre * sumI0;
+    i1e = iPre * sumI1;
+
+    // I_nu(z) ~ [e^z * sum((-1)^k a_k / z^k) + e^(-z +/- (nu+1/2)*pi*i) * sum(a_k / z^k)] / sqrt(2*pi*z)
+    if (z.real() < 20.0) {
+        Complex e2 = std::exp(-2.0 * z);
+        Complex rot = (z.imag() >= 0.0) ? Complex(0.0, 1.0) : Complex(0.0, -1.0);
+        i0e += iPre * e2 * rot * sumK0;
+        i1e -= iPre * e2 * rot * sumK1;
+    }
+}
+
+// ==================== 实数自变量 ====================
+
+namespace {
+template<int N>
+inline int length(const double (&)[N]) { return N; }
+}
+
+double BesselFunctions::i0e(double x)
+{
+    x = std::abs(x);
+    if (x <= 2.0) return chebyshev(kI0Small, 0.5 * x * x - 1.0) * std::exp(-x);
+    if (x <= 8.0) return chebyshev(kI0Mid, (x - 5.0) / 3.0);
+    return chebyshev(kI0Large, 16.0 / x - 1.0) / std::sqrt(x);
+}
+
+double BesselFunctions::i1e(double x)
+{
+    double ax = std::abs(x);
+    double r;
+    if (ax <= 2.0) r = chebyshev(kI1Small, 0.5 * ax * ax - 1.0) * ax * std::exp(-ax);
+    else if (ax <= 8.0) r = chebyshev(kI1Mid, (ax - 5.0) / 3.0);
+    else r = chebyshev(kI1Large, 16.0 / ax - 1.0) / std::sqrt(ax);
+    return (x < 0.0) ? -r : r;
+}
+
+// 小自变量: K0(x) = f(t) - ln(x/2) * I0(x)，两段级数共用 t = x^2/2 - 1
+double BesselFunctions::k0(double x)
+{
+    if (x <= 0.0) return std::numeric_limits<double>::infinity();
+    if (x <= 2.0) {
+        double t = 0.5 * x * x - 1.0;
+        return chebyshev(kK0Small, t) - std::log(0.5 * x) * chebyshev(kI0Small, t);
+    }
+    return chebyshev(kK0Large, 4.0 / x - 1.0) / std::sqrt(x) * std::exp(-x);
+}
+
+// 小自变量: K1(x) = f(t) / x + ln(x/2) * I1(x)
+double BesselFunctions::k1(double x)
+{
+    if (x <= 0.0) return std::numeric_limits<double>::infinity();
+    if (x <= 2.0) {
+        double t = 0.5 * x * x - 1.0;
+        return chebyshev(kK1Small, t) / x + std::log(0.5 * x) * x * chebyshev(kI1Small, t);
+    }
+    return chebyshev(kK1Large, 4.0 / x - 1.0) / std::sqrt(x) * std::exp(-x);
+}
+
+double BesselFunctions::k0e(double x)
+{
+    if (x <= 0.0) return std::numeric_limits<double>::infinity();
+    if (x <= 2.0) return k0(x) * std::exp(x);
+    return chebyshev(kK0Large, 4.0 / x - 1.0) / std::sqrt(x);
+}
+
+double BesselFunctions::k1e(double x)
+{
+    if (x <= 0.0) return std::numeric_limits<double>::infinity();
+    if (x <= 2.0) return k1(x) * std::exp(x);
+    return chebyshev(kK1Large, 4.0 / x - 1.0) / std::sqrt(x);
+}
+
+// ==================== 批量接口 ====================
+
+#if defined(WT_BESSEL_AVX2)
+namespace {
+// 4 路向量部分，返回已处理的个数 (余下不足 4 个的由调用者逐个计算)
+WT_BESSEL_AVX2_TARGET int i0eBatch4(const double* x, double* out, int n)
+{
+    int i = 0;
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    for (; i + 4 <= n; i += 4) {
+        __m256d ax = _mm256_andnot_pd(signMask, _mm256_loadu_pd(x + i));
+        int mask = smallMask(ax);
+        if (mask != 0xF) _mm256_storeu_pd(out + i, iLarge4(kI0Mid, length(kI0Mid), kI0Large, length(kI0Large), ax));
+        for (int j = 0; mask != 0 && j < 4; ++j) {
+            if (mask & (1 << j)) out[i + j] = BesselFunctions::i0e(x[i + j]);
+        }
+    }
+    return i;
+}
+
+WT_BESSEL_AVX2_TARGET int i1eBatch4(const double* x, double* out, int n)
+{
+    int i = 0;
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(x + i);
+        __m256d ax = _mm256_andnot_pd(signMask, v);
+        int mask = smallMask(ax);
+        if (mask != 0xF) {
+            __m256d r = iLarge4(kI1Mid, length(kI1Mid), kI1Large, length(kI1Large), ax);
+            // I1 为奇函数：恢复自变量符号
+            _mm256_storeu_pd(out + i, _mm256_or_pd(r, _mm256_and_pd(v, signMask)));
+        }
+        for (int j = 0; mask != 0 && j < 4; ++j) {
+            if (mask & (1 << j)) out[i + j] = BesselFunctions::i1e(x[i + j]);
+        }
+    }
+    return i;
+}
+
+WT_BESSEL_AVX2_TARGET int k0eBatch4(const double* x, double* out, int n)
+{
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(x + i);
+        int mask = smallMask(v);
+        if (mask != 0xF) _mm256_storeu_pd(out + i, kLarge4(kK0Large, length(kK0Large), v));
+        for (int j = 0; mask != 0 && j < 4; ++j) {
+            if (mask & (1 << j)) out[i + j] = BesselFunctions::k0e(x[i + j]);
+        }
+    }
+    return i;
+}
+
+WT_BESSEL_AVX2_TARGET int k1eBatch4(const double* x, double* out, int n)
+{
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(x + i);
+        int mask = smallMask(v);
+        if (mask != 0xF) _mm256_storeu_pd(out + i, kLarge4(kK1Large, length(kK1Large), v));
+        for (int j = 0; mask != 0 && j < 4; ++j) {
+            if (mask & (1 << j)) out[i + j] = BesselFunctions::k1e(x[i + j]);
+        }
+    }
+    return i;
+}
+
+WT_BESSEL_AVX2_TARGET int k0i0eBatch4(const double* x, double* k0Out, double* i0eOut, int n)
+{
+    int i = 0;
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(x + i);
+        int mask = smallMask(v);
+        if (mask != 0xF) {
+            _mm256_storeu_pd(i0eOut + i, iLarge4(kI0Mid, length(kI0Mid), kI0Large, length(kI0Large), _mm256_andnot_pd(signMask, v)));
+            _mm256_storeu_pd(k0Out + i, kLarge4(kK0Large, length(kK0Large), v));
+        }
+        for (int j = 0; j < 4; ++j) {
+            double xj = x[i + j];
+            if (mask & (1 << j)) {
+                // 小自变量: K0 与 I0 共用 t
+                double t = 0.5 * xj * xj - 1.0;
+                double I0 = chebyshev(kI0Small, t);
+                k0Out[i + j] = (xj > 0.0) ? chebyshev(kK0Small, t) - std::log(0.5 * xj) * I0
+                                          : std::numeric_limits<double>::infinity();
+                i0eOut[i + j] = I0 * std::exp(-std::abs(xj));
+            } else {
+                k0Out[i + j] *= std::exp(-xj);
+            }
+        }
+    }
+    return i;
+}
+}
+#endif
+
+void BesselFunctions::i0eBatch(const double* x, double* out, int n)
+{
+    int i = 0;
+#if defined(WT_BESSEL_AVX2)
+    if (hasAvx2()) i = i0eBatch4(x, out, n);
+#endif
+    for (; i < n; ++i) out[i] = i0e(x[i]);
+}
+
+void BesselFunctions::i1eBatch(const double* x, double* out, int n)
+{
+    int i = 0;
+#if defined(WT_BESSEL_AVX2)
+    if (hasAvx2()) i = i1eBatch4(x, out, n);
+#endif
+    for (; i < n; ++i) out[i] = i1e(x[i]);
+}
+
+void BesselFunctions::k0eBatch(const double* x, double* out, int n)
+{
+    int i = 0;
+#if defined(WT_BESSEL_AVX2)
+    if (hasAvx2()) i = k0eBatch4(x, out, n);
+#endif
+    for (; i < n; ++i) out[i] = k0e(x[i]);
+}
+
+void BesselFunctions::k1eBatch(const double* x, double* out, int n)
+{
+    int i = 0;
+#if defined(WT_BESSEL_AVX2)
+    if (hasAvx2()) i = k1eBatch4(x, out, n);
+#endif
+    for (; i < n; ++i) out[i] = k1e(x[i]);
+}
+
+void BesselFunctions::k0i0eBatch(const double* x, double* k0Out, double* i0eOut, int n)
+{
+    int i = 0;
+#if defined(WT_BESSEL_AVX2)
+    if (hasAvx2()) i = k0i0eBatch4(x, k0Out, i0eOut, n);
+#endif
+    for (; i < n; ++i) {
+        k0Out[i] = k0(x[i]);
+        i0eOut[i] = i0e(x[i]);
+    }
+}
@@ -0,0 +1,62 @@
+/*
+ * besselfunctions.h
+ * 文件作用: 试井模型专用 Bessel 函数库头文件
+ * 功能描述:
+ * 1. 提供 0 阶、1 阶第一类/第二类修正 Bessel 函数 (I0, I1, K0, K1) 的指数缩放形式。
+ * 2. 支持复数自变量，供 Talbot、de Hoog 等复数拉普拉斯反演方法计算复数拉普拉斯函数使用。
+ * 3. 实数自变量使用分段 Chebyshev 逼近 (专用于 0/1 阶，相对误差约 1e-15)，替代通用阶数的 boost 实现。
+ * 4. 提供批量接口，CPU 支持 AVX2 时每次同时计算 4 个自变量，否则逐个计算。GCC/Clang 默认构建即按函数编译 AVX2 版本、
+ *    运行时检测 CPU；MSVC 需要 /arch:AVX2 才启用向量路径。
+ * 5. 纯数学计算，不依赖任何 UI 控件。
+ */
+
+#ifndef BESSELFUNCTIONS_H
+#define BESSELFUNCTIONS_H
+
+#include <complex>
+
+class BesselFunctions
+{
+public:
+    using Complex = std::complex<double>;
+
+    // 复数自变量的指数缩放 K 函数: k0e(z) = exp(z) * K0(z), k1e(z) = exp(z) * K1(z)
+    // 要求 Re(z) >= 0 (平方根主值分支始终满足该条件)
+    static void k01e(Complex z, Complex& k0e, Complex& k1e);
+
+    // 复数自变量的指数缩放 I 函数: i0e(z) = exp(-z) * I0(z), i1e(z) = exp(-z) * I1(z)
+    static void i01e(Complex z, Complex& i0e, Complex& i1e);
+
+    // 同时计算四个缩放函数 (共用连分式中间结果，比分别调用更快)
+    static void all01e(Complex z, Complex& k0e, Complex& k1e, Complex& i0e, Complex& i1e);
+
+    // ---- 实数自变量 ----
+    // 指数缩放形式: i0e(x) = exp(-|x|) * I0(x)，k0e(x) = exp(x) * K0(x) (K 函数要求 x > 0)
+    static double i0e(double x);
+    static double i1e(double x);
+    static double k0e(double x);
+    static double k1e(double x);
+
+    // 不缩放的 K 函数 (小自变量时直接计算，避免先缩放再还原)
+    static double k0(double x);
+    static double k1(double x);
+
+    // ---- 批量接口: out[i] = f(x[i])，i = 0..n-1 ----
+    static void i0eBatch(const double* x, double* out, int n);
+    static void i1eBatch(const double* x, double* out, int n);
+    static void k0eBatch(const double* x, double* out, int n);
+    static void k1eBatch(const double* x, double* out, int n);
+
+    // 积分核组合: 同时计算不缩放 K0 与缩放 I0
+    static void k0i0eBatch(const double* x, double* k0Out, double* i0eOut, int n);
+
+private:
+    // 小自变量 (|z| <= 2) 幂级数
+    static void seriesSmall(Complex z, Complex& k0e, Complex& k1e, Complex& i0e, Complex& i1e);
+    // 中等自变量 Steed 连分式 (CF2) 求 K，CF1 连分式加 Wronskian 关系求 I
+    static void continuedFraction(Complex z, Complex& k0e, Complex& k1e, Complex& i0e, Complex& i1e);
+    // 大自变量渐近展开
+    static void asymptotic(Complex z, Complex& k0e, Complex& k1e, Complex& i0e, Complex& i1e);
+};
+
+#endif // BESSELFUNCTIONS_H
@@ -0,0 +1,119 @@
+/*
+ * curveinterpolator.cpp
+ * 文件作用: 曲线插值工具实现
+ * 功能描述:
+ * 1. 内部节点斜率取相邻割线斜率的加权调和平均 (割线异号或为零时斜率取 0)，端点使用保形三点公式。
+ * 2. 查询点递增时顺序推进区间下标，否则二分查找。
+ * 3. 斜率计算直接写入调用者的缓冲区，拟合中反复插值到同一组查询点时不分配内存。
+ */
+
+#include "curveinterpolator.h"
+
+#include <algorithm>
+#include <cmath>
+
+void CurveInterpolator::pchipSlopes(const double* x, const double* y, int n, double* d)
+{
+    if (n < 2) {
+        if (n == 1) d[0] = 0.0;
+        return;
+    }
+
+    auto h = [x](int i) { return x[i + 1] - x[i]; };
+    auto delta = [x, y](int i) { return (y[i + 1] - y[i]) / (x[i + 1] - x[i]); };
+
+    if (n == 2) {
+        d[0] = d[1] = delta(0);
+        return;
+    }
+
+    // 内部节点：加权调和平均
+    for (int i = 1; i < n - 1; ++i) {
+        double del0 = delta(i - 1);
+        double del1 = delta(i);
+        if (del0 * del1 <= 0.0) {
+            d[i] = 0.0;
+        } else {
+            double w1 = 2.0 * h(i) + h(i - 1);
+            double w2 = h(i) + 2.0 * h(i - 1);
+            d[i] = (w1 + w2) / (w1 / del0 + w2 / del1);
+        }
+    }
+
+    // 端点：非中心三点公式，并保持单调
+    auto endSlope = [](double h0, double h1, double del0, double del1) {
+        double s = ((2.0 * h0 + h1) * del0 - h0 * del1) / (h0 + h1);
+        if (s * del0 <= 0.0) return 0.0;
+        if (del0 * del1 < 0.0 && std::abs(s) > std::abs(3.0 * del0)) return 3.0 * del0;
+        return s;
+    };
+    d[0] = endSlope(h(0), h(1), delta(0), delta(1));
+    d[n - 1] = endSlope(h(n - 2), h(n - 3), delta(n - 2), delta(n - 3));
+}
+
+QVector<double> CurveInterpolator::pchipSlopes(const QVector<double>& x, const QVector<double>& y)
+{
+    QVector<double> d(x.size(), 0.0);
+    pchipSlopes(x.constData(), y.constData(), x.size(), d.data());
+    return d;
+}
+
+QVector<double> CurveInterpolator::pchip(const QVector<double>& x, const QVector<double>& y, const QVector<double>& xi)
+{
+    int n = x.size();
+    QVector<double> out(xi.size(), 0.0);
+    if (n == 0 || y.size() != n) return out;
+    if (n == 1) {
+        out.fill(y[0]);
+        return out;
+    }
+
+    QVector<double> d = pchipSlopes(x, y);
+    int seg = 0;
+    for (int k = 0; k < xi.size(); ++k) {
+        double v = xi[k];
+        if (v <= x[0]) { out[k] = y[0]; continue; }
+        if (v >= x[n - 1]) { out[k] = y[n - 1]; continue; }
+
+        // 递增查询时顺序推进，否则二分查找
+        if (v < x[seg]) seg = 0;
+        if (v >= x[seg + 1]) {
+            if (seg + 2 < n && v < x[seg + 2]) {
+                ++seg;
+            } else {
+                seg = int(std::upper_bound(x.constBegin(), x.constEnd(), v) - x.constBegin()) - 1;
+            }
+        }
+
+        double h = x[seg + 1] - x[seg];
+        double s = (v - x[seg]) / h;
+        double s2 = s * s;
+        double s3 = s2 * s;
+        double h00 = 2.0 * s3 - 3.0 * s2 + 1.0;
+        double h10 = s3 - 2.0 * s2 + s;
+        double h01 = -2.0 * s3 + 3.0 * s2;
+        double h11 = s3 - s2;
+        out[k] = h00 * y[seg] + h10 * h * d[seg] + h01 * y[seg + 1] + h11 * h * d[seg + 1];
+    }
+    return out;
+}
+
+QVector<double> CurveInterpolator::pchipLogLog(const QVector<double>& x, const QVector<double>& y, const QVector<double>& xi)
+{
+    int n = x.size();
+    QVector<double> lx(n), lxi(xi.size());
+    for (int i = 0; i < n; ++i) lx[i] = std::log(x[i]);
+    for (int i = 0; i < xi.size(); ++i) lxi[i] = std::log(xi[i]);
+
+    bool positive = true;
+    for (double v : y) {
+        if (!(v > 0.0)) { positive = false; break; }
+    }
+    if (!positive) return pchip(lx, y, lxi);
+
+    QVector<double> ly(n);
+    for (int i = 0; i < n; ++i) ly[i] = std::log(y[i]);
+    QVector<double> out = pchip(lx, ly, lxi);
+    for (double& v : out) v = std::exp(v);
+    return out;
+}
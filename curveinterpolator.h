@@ -0,0 +1,32 @@
+/*
+ * curveinterpolator.h
+ * 文件作用: 曲线插值工具头文件
+ * 功能描述:
+ * 1. 单调保形分段三次 Hermite 插值 (PCHIP, Fritsch-Carlson)，不产生过冲，适合压力/导数曲线。
+ * 2. 双对数插值：在 (log x, log y) 空间插值，曲线全为正值时使用；含非正值时退回 (log x, y) 半对数插值。
+ * 3. 超出节点范围的点按端点值处理 (不外推)。
+ */
+
+#ifndef CURVEINTERPOLATOR_H
+#define CURVEINTERPOLATOR_H
+
+#include <QVector>
+
+class CurveInterpolator
+{
+public:
+    // PCHIP 插值：x 严格递增，返回 xi 处的插值结果
+    static QVector<double> pchip(const QVector<double>& x, const QVector<double>& y, const QVector<double>& xi);
+
+    // 双对数 PCHIP 插值：x 与 xi 须为正值
+    static QVector<double> pchipLogLog(const QVector<double>& x, const QVector<double>& y, const QVector<double>& xi);
+
+    // PCHIP 节点斜率写入 d (d 须有 n 个元素，不分配内存)
+    static void pchipSlopes(const double* x, const double* y, int n, double* d);
+
+private:
+    // 计算 PCHIP 节点斜率
+    static QVector<double> pchipSlopes(const QVector<double>& x, const QVector<double>& y);
+};
+
+#endif // CURVEINTERPOLATOR_H
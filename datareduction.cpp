@@ -0,0 +1,155 @@
+/*
+ * datareduction.cpp
+ * 文件作用: 实测数据抽稀实现
+ * 功能描述:
+ * 1. 时间箱编号 k = floor(log10(t) * pointsPerCycle)，箱边界对齐到整数对数刻度，与数据起点无关；
+ *    流动段内时间不减 (允许重复时间戳)，同一箱的样本是连续的一段，顺序扫描即可。
+ * 2. 离散程度取箱内对数值相对 ln v ~ ln t 直线拟合的残差 (扣除箱内曲线本身的变化，只保留噪声)。
+ *    标准误差：均值法为残差标准差 / sqrt(n)；中位数法为 1.2533 * 1.4826 * MAD / sqrt(n)
+ *    (正态分布下中位数的标准误差约为均值的 1.2533 倍)。
+ * 3. 非正时间的样本不参与分箱，原样保留为单独的点。
+ */
+
+#include "datareduction.h"
+
+#include <algorithm>
+#include <cmath>
+
+QVector<int> DataReduction::flowPeriodStarts(const QVector<double>& t)
+{
+    QVector<int> starts;
+    if (t.isEmpty()) return starts;
+    starts.append(0);
+    for (int i = 1; i < t.size(); ++i) {
+        if (t[i] < t[i - 1]) starts.append(i);
+    }
+    return starts;
+}
+
+double DataReduction::center(QVector<double>& values, Method method)
+{
+    int n = values.size();
+    if (n == 0) return 0.0;
+    if (method == Mean) {
+        double sum = 0.0;
+        for (double v : values) sum += v;
+        return sum / n;
+    }
+    std::nth_element(values.begin(), values.begin() + n / 2, values.end());
+    double upper = values[n / 2];
+    if (n % 2) return upper;
+    double lower = *std::max_element(values.begin(), values.begin() + n / 2);
+    return 0.5 * (lower + upper);
+}
+
+double DataReduction::logStandardError(const QVector<double>& t, const QVector<double>& values, Method method)
+{
+    QVector<double> x, y;
+    x.reserve(values.size());
+    y.reserve(values.size());
+    for (int i = 0; i < values.size(); ++i) {
+        if (values[i] > 0.0 && t[i] > 0.0) {
+            x.append(std::log(t[i]));
+            y.append(std::log(values[i]));
+        }
+    }
+    int n = y.size();
+    if (n < 3) return -1.0;
+
+    // 1. 箱内直线趋势
+    double mx = center(x, Mean);
+    double my = center(y, Mean);
+    double sxx = 0.0, sxy = 0.0;
+    for (int i = 0; i < n; ++i) {
+        sxx += (x[i] - mx) * (x[i] - mx);
+        sxy += (x[i] - mx) * (y[i] - my);
+    }
+    double slope = sxx > 0.0 ? sxy / sxx : 0.0;
+    for (int i = 0; i < n; ++i) y[i] -= my + slope * (x[i] - mx);
+
+    // 2. 残差的离散程度
+    if (method == Mean) {
+        double ss = 0.0;
+        for (double v : y) ss += v * v;
+        return std::sqrt(ss / (n - 2)) / std::sqrt(double(n));
+    }
+    double median = center(y, Median);
+    for (double& v : y) v = std::abs(v - median);
+    double mad = center(y, Median);
+    return 1.2533 * 1.4826 * mad / std::sqrt(double(n));
+}
+
+QVector<double> DataReduction::weightsFromErrors(const QVector<double>& errors)
+{
+    QVector<double> weights(errors.size(), 1.0);
+    QVector<double> known;
+    for (double e : errors) {
+        if (e > 0.0) known.append(e);
+    }
+    if (known.isEmpty()) return weights;
+
+    double reference = center(known, Median);
+    double sumSquares = 0.0;
+    for (int i = 0; i < errors.size(); ++i) {
+        double e = errors[i] > 0.0 ? std::min(std::max(errors[i], 0.1 * reference), 10.0 * reference) : reference;
+        weights[i] = reference / e;
+        sumSquares += weights[i] * weights[i];
+    }
+    double scale = std::sqrt(errors.size() / sumSquares);
+    for (double& w : weights) w *= scale;
+    return weights;
+}
+
+DataReduction::Result DataReduction::reduce(const QVector<double>& t, const QVector<double>& deltaP, const QVector<double>& derivative, const Options& options)
+{
+    Result result;
+    int n = std::min(t.size(), deltaP.size());
+    bool hasDerivative = (derivative.size() >= n);
+    double perCycle = std::max(1, options.pointsPerCycle);
+
+    QVector<double> errorsP, errorsD;
+    QVector<double> binT, binP, binD;
+    QVector<int> starts = flowPeriodStarts(t.mid(0, n));
+    result.flowPeriods = starts.size();
+
+    for (int s = 0; s < starts.size(); ++s) {
+        int begin = starts[s];
+        int end = (s + 1 < starts.size()) ? starts[s + 1] : n;
+
+        int i = begin;
+        while (i < end) {
+            // 1. 收集同一时间箱的连续样本
+            int j = i + 1;
+            if (t[i] > 0.0) {
+                double bin = std::floor(std::log10(t[i]) * perCycle);
+                while (j < end && std::floor(std::log10(t[j]) * perCycle) == bin) ++j;
+            }
+
+            binT = t.mid(i, j - i);
+            binP = deltaP.mid(i, j - i);
+            if (hasDerivative) binD = derivative.mid(i, j - i);
+
+            // 2. 箱内离散程度
+            errorsP.append(logStandardError(binT, binP, options.method));
+            if (hasDerivative) errorsD.append(logStandardError(binT, binD, options.method));
+
+            // 3. 代表值
+            if (options.method == Mean && binT.size() > 1) {
+                double sumLog = 0.0;
+                for (double v : binT) sumLog += std::log(v);
+                result.time.append(std::exp(sumLog / binT.size()));
+            } else {
+                result.time.append(center(binT, Median));
+            }
+            result.deltaP.append(center(binP, options.method));
+            if (hasDerivative) result.derivative.append(center(binD, options.method));
+            result.count.append(j - i);
+
+            i = j;
+        }
+    }
+
+    result.weightP = weightsFromErrors(errorsP);
+    result.weightD = hasDerivative ? weightsFromErrors(errorsD) : QVector<double>();
+    return result;
+}
@@ -0,0 +1,54 @@
+/*
+ * datareduction.h
+ * 文件作用: 实测数据抽稀头文件 (对数时间分箱)
+ * 功能描述:
+ * 1. 按每个对数周期固定点数划分时间箱，箱内样本合并为一个点 (中位数或均值)，压差与导数分别合并。
+ * 2. 由箱内离散程度给出每个点的残差权重：箱内对数值的标准误差越小，权重越大。
+ * 3. 时间减小处视为新的流动段起点，时间箱不跨越流动段边界；重复的时间戳 (采样分辨率不足) 留在当前箱内合并。
+ * 4. 只做数据整理，不修改原始序列；原始序列由调用者保留。
+ */
+
+#ifndef DATAREDUCTION_H
+#define DATAREDUCTION_H
+
+#include <QVector>
+
+class DataReduction
+{
+public:
+    enum Method {
+        Median = 0,     // 中位数 (抗野值)，离散程度用中位数绝对偏差估计
+        Mean            // 算术平均，离散程度用标准差估计
+    };
+
+    struct Options {
+        int pointsPerCycle = 20;        // 每个对数周期 (十倍时间) 的时间箱数
+        Method method = Median;
+    };
+
+    struct Result {
+        QVector<double> time;           // 箱内时间的中位数 (中位数法) 或几何平均 (均值法)
+        QVector<double> deltaP;
+        QVector<double> derivative;     // 原始导数为空时也为空
+        QVector<double> weightP;        // 压差残差权重 (平方平均为 1)
+        QVector<double> weightD;        // 导数残差权重
+        QVector<int> count;             // 每个点合并的原始样本数
+        int flowPeriods = 0;
+    };
+
+    // 抽稀：t、deltaP 等长，derivative 为空或与 t 等长
+    static Result reduce(const QVector<double>& t, const QVector<double>& deltaP, const QVector<double>& derivative, const Options& options);
+
+    // 各流动段第一个样本的下标 (时间减小处开始新的流动段，相等不算)
+    static QVector<int> flowPeriodStarts(const QVector<double>& t);
+
+private:
+    // 箱内代表值 (values 会被重排)
+    static double center(QVector<double>& values, Method method);
+    // 箱内对数值代表值的标准误差 (扣除箱内 ln v ~ ln t 的直线趋势)；有效样本少于 3 个时返回 -1 (未知)
+    static double logStandardError(const QVector<double>& t, const QVector<double>& values, Method method);
+    // 标准误差换算为权重：以已知标准误差的中位数为基准，比值限制在 [0.1, 10]，未知的取基准，最后归一化
+    static QVector<double> weightsFromErrors(const QVector<double>& errors);
+};
+
+#endif // DATAREDUCTION_H
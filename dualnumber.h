@@ -0,0 +1,226 @@
+/*
+ * dualnumber.h
+ * 文件作用: 前向自动微分用对偶数 (仅头文件，模板实现)
+ * 功能描述:
+ * 1. Dual<T, N> 保存函数值 val 及其对 N 个参数方向的偏导 der[N]，T 为 double 或 std::complex<double>。
+ * 2. 重载四则运算与 sqrt、exp、log，按链式法则同时传播偏导；偏导为定长数组，不做堆分配。
+ *    函数值部分的运算顺序与普通标量完全相同，因此函数值与不求导时的计算结果一致。
+ * 3. abs、real 只作用于函数值部分，返回 double，供比较、误差估计等控制流判断使用 (控制流不参与求导)。
+ * 4. 数学函数以友元形式定义，模板代码中写 using std::exp; 后不加限定调用即可同时支持普通标量与对偶数。
+ * 5. DualTraits 供模板代码区分对偶数与普通标量：Param 为模型参数的类型 (普通标量求值时为 double)，
+ *    realValue 取函数值的实部。
+ */
+
+#ifndef DUALNUMBER_H
+#define DUALNUMBER_H
+
+#include <cmath>
+#include <complex>
+#include <type_traits>
+
+template<typename T, int N>
+class Dual
+{
+private:
+    struct NoInit {};
+    explicit Dual(NoInit) {}
+
+    template<typename S>
+    struct IsScalar : std::integral_constant<bool, std::is_arithmetic<S>::value || std::is_same<S, T>::value> {};
+
+    // 实数常数统一转为 double (std::complex 不支持与 int 直接运算)
+    template<typename S>
+    static typename std::conditional<std::is_arithmetic<S>::value, double, T>::type lift(const S& s) { return s; }
+
+    void clearDerivatives()
+    {
+        for (int k = 0; k < N; ++k) der[k] = T(0.0);
+    }
+
+public:
+    using Scalar = T;
+    static const int Size = N;
+
+    T val;        // 函数值
+    T der[N];     // 对各参数方向的偏导
+
+    Dual() : val(0.0) { clearDerivatives(); }
+    Dual(const T& value) : val(value) { clearDerivatives(); }
+    // 实数常数 (T 为复数时 double 不能经两次隐式转换得到 Dual，需单独提供)
+    template<typename S, typename std::enable_if<std::is_arithmetic<S>::value, int>::type = 0>
+    Dual(S value) : val(double(value)) { clearDerivatives(); }
+
+    // 自变量：函数值为 value，对第 direction 个方向的偏导为 1
+    static Dual variable(const T& value, int direction)
+    {
+        Dual r(value);
+        r.der[direction] = T(1.0);
+        return r;
+    }
+
+    // ---- 四则运算 ----
+    friend Dual operator-(const Dual& a)
+    {
+        Dual r(NoInit{});
+        r.val = -a.val;
+        for (int k = 0; k < N; ++k) r.der[k] = -a.der[k];
+        return r;
+    }
+
+    friend Dual operator+(const Dual& a, const Dual& b)
+    {
+        Dual r(NoInit{});
+        r.val = a.val + b.val;
+        for (int k = 0; k < N; ++k) r.der[k] = a.der[k] + b.der[k];
+        return r;
+    }
+
+    friend Dual operator-(const Dual& a, const Dual& b)
+    {
+        Dual r(NoInit{});
+        r.val = a.val - b.val;
+        for (int k = 0; k < N; ++k) r.der[k] = a.der[k] - b.der[k];
+        return r;
+    }
+
+    friend Dual operator*(const Dual& a, const Dual& b)
+    {
+        Dual r(NoInit{});
+        r.val = a.val * b.val;
+        for (int k = 0; k < N; ++k) r.der[k] = a.der[k] * b.val + a.val * b.der[k];
+        return r;
+    }
+
+    friend Dual operator/(const Dual& a, const Dual& b)
+    {
+        Dual r(NoInit{});
+        r.val = a.val / b.val;
+        for (int k = 0; k < N; ++k) r.der[k] = (a.der[k] - r.val * b.der[k]) / b.val;
+        return r;
+    }
+
+    // 与标量 (实数常数或 T) 的运算：标量偏导为零，省去对应的乘加
+    template<typename S, typename std::enable_if<IsScalar<S>::value, int>::type = 0>
+    friend Dual operator+(const Dual& a, const S& s)
+    {
+        Dual r(a);
+        r.val = a.val + lift(s);
+        return r;
+    }
+
+    template<typename S, typename std::enable_if<IsScalar<S>::value, int>::type = 0>
+    friend Dual operator+(const S& s, const Dual& a)
+    {
+        Dual r(a);
+        r.val = lift(s) + a.val;
+        return r;
+    }
+
+    template<typename S, typename std::enable_if<IsScalar<S>::value, int>::type = 0>
+    friend Dual operator-(const Dual& a, const S& s)
+    {
+        Dual r(a);
+        r.val = a.val - lift(s);
+        return r;
+    }
+
+    template<typename S, typename std::enable_if<IsScalar<S>::value, int>::type = 0>
+    friend Dual operator-(const S& s, const Dual& a)
+    {
+        Dual r(NoInit{});
+        r.val = lift(s) - a.val;
+        for (int k = 0; k < N; ++k) r.der[k] = -a.der[k];
+        return r;
+    }
+
+    template<typename S, typename std::enable_if<IsScalar<S>::value, int>::type = 0>
+    friend Dual operator*(const Dual& a, const S& s)
+    {
+        Dual r(NoInit{});
+        r.val = a.val * lift(s);
+        for (int k = 0; k < N; ++k) r.der[k] = a.der[k] * lift(s);
+        return r;
+    }
+
+    template<typename S, typename std::enable_if<IsScalar<S>::value, int>::type = 0>
+    friend Dual operator*(const S& s, const Dual& a)
+    {
+        Dual r(NoInit{});
+        r.val = lift(s) * a.val;
+        for (int k = 0; k < N; ++k) r.der[k] = lift(s) * a.der[k];
+        return r;
+    }
+
+    template<typename S, typename std::enable_if<IsScalar<S>::value, int>::type = 0>
+    friend Dual operator/(const Dual& a, const S& s)
+    {
+        Dual r(NoInit{});
+        r.val = a.val / lift(s);
+        for (int k = 0; k < N; ++k) r.der[k] = a.der[k] / lift(s);
+        return r;
+    }
+
+    template<typename S, typename std::enable_if<IsScalar<S>::value, int>::type = 0>
+    friend Dual operator/(const S& s, const Dual& a)
+    {
+        Dual r(NoInit{});
+        r.val = lift(s) / a.val;
+        for (int k = 0; k < N; ++k) r.der[k] = -r.val * a.der[k] / a.val;
+        return r;
+    }
+
+    Dual& operator+=(const Dual& b) { return *this = *this + b; }
+    Dual& operator-=(const Dual& b) { return *this = *this - b; }
+    Dual& operator*=(const Dual& b) { return *this = *this * b; }
+    Dual& operator/=(const Dual& b) { return *this = *this / b; }
+
+    // ---- 初等函数 ----
+    friend Dual sqrt(const Dual& a)
+    {
+        Dual r(NoInit{});
+        r.val = std::sqrt(a.val);
+        T scale = T(0.5) / r.val;
+        for (int k = 0; k < N; ++k) r.der[k] = scale * a.der[k];
+        return r;
+    }
+
+    friend Dual exp(const Dual& a)
+    {
+        Dual r(NoInit{});
+        r.val = std::exp(a.val);
+        for (int k = 0; k < N; ++k) r.der[k] = r.val * a.der[k];
+        return r;
+    }
+
+    friend Dual log(const Dual& a)
+    {
+        Dual r(NoInit{});
+        r.val = std::log(a.val);
+        for (int k = 0; k < N; ++k) r.der[k] = a.der[k] / a.val;
+        return r;
+    }
+
+    // 仅函数值部分 (控制流判断用)
+    friend double abs(const Dual& a) { return std::abs(a.val); }
+    friend double real(const Dual& a) { return std::real(a.val); }
+};
+
+template<typename T>
+struct DualTraits
+{
+    static const bool isDual = false;
+    using Scalar = T;
+    using Param = double;
+    static double realValue(double x) { return x; }
+};
+
+template<typename T, int N>
+struct DualTraits<Dual<T, N>>
+{
+    static const bool isDual = true;
+    using Scalar = T;
+    using Param = Dual<T, N>;
+    static double realValue(const Dual<T, N>& x) { return std::real(x.val); }
+};
+
+#endif // DUALNUMBER_H
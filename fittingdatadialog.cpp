@@ -6,6 +6,7 @@
  * 2. 实现智能列名识别，自动匹配 Time, Pressure 等列。
  * 3. 实现试井类型切换逻辑：降落试井需输入地层压力，恢复试井自动计算。
  * 4. [修改] 适配多文件数据源，实现项目文件切换与预览联动。
+ * 5. 数据抽稀选项 (对数分箱) 随复选框启用/禁用。
  */
 
 #include "fittingdatadialog.h"
@@ -60,6 +61,9 @@ FittingDataDialog::FittingDataDialog(const QMap<QString, QStandardItemModel*>& p
     // 连接平滑复选框
     connect(ui->checkSmoothing, &QCheckBox::toggled, this, &FittingDataDialog::onSmoothingToggled);
 
+    // 连接抽稀复选框
+    connect(ui->checkReduction, &QCheckBox::toggled, this, &FittingDataDialog::onReductionToggled);
+
     // 重写确定按钮逻辑，先进行校验
     connect(ui->buttonBox->button(QDialogButtonBox::Ok), &QPushButton::clicked, this, &FittingDataDialog::onAccepted);
     // 断开默认的 accepted 信号，由 onAccepted 手动调用 accept()
@@ -353,6 +357,13 @@ void FittingDataDialog::onSmoothingToggled(bool checked)
     ui->spinSmoothSpan->setEnabled(checked);
 }
 
+// 抽稀选项切换
+void FittingDataDialog::onReductionToggled(bool checked)
+{
+    ui->comboReductionMethod->setEnabled(checked);
+    ui->spinPointsPerCycle->setEnabled(checked);
+}
+
 // 获取设置结果
 FittingDataSettings FittingDataDialog::getSettings() const
 {
@@ -388,6 +399,10 @@ FittingDataSettings FittingDataDialog::getSettings() const
     s.enableSmoothing = ui->checkSmoothing->isChecked();
     s.smoothingSpan = ui->spinSmoothSpan->value();
 
+    s.enableReduction = ui->checkReduction->isChecked();
+    s.pointsPerCycle = ui->spinPointsPerCycle->value();
+    s.reductionMethod = ui->comboReductionMethod->currentIndex();
+
     return s;
 }
 
@@ -6,6 +6,7 @@
  * 2. 声明 FittingDataDialog 类，提供从项目或文件加载数据、预览数据、配置列映射的界面。
  * 3. [修改] 支持多文件数据源选择，在“项目数据”模式下可切换不同文件。
  * 4. 包含了文件解析逻辑（CSV, TXT, Excel）。
+ * 5. 数据抽稀配置：对数时间分箱的每周期点数与箱内合并方式 (中位数/均值)。
  */
 
 #ifndef FITTINGDATADIALOG_H
@@ -44,6 +45,10 @@ struct FittingDataSettings {
 
     bool enableSmoothing;       // 是否启用平滑
     int smoothingSpan;          // 平滑窗口大小 (奇数)
+
+    bool enableReduction;       // 是否按对数时间分箱抽稀
+    int pointsPerCycle;         // 每个对数周期的点数
+    int reductionMethod;        // 箱内合并方式 (0: 中位数, 1: 均值)
 };
 
 class FittingDataDialog : public QDialog
@@ -80,6 +85,9 @@ private slots:
     // 启用平滑复选框切换时触发
     void onSmoothingToggled(bool checked);
 
+    // 启用抽稀复选框切换时触发
+    void onReductionToggled(bool checked);
+
     // 点击确定按钮时的校验
     void onAccepted();
 
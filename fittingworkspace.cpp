@@ -0,0 +1,205 @@
+/*
+ * fittingworkspace.cpp
+ * 文件作用: 拟合残差与雅可比矩阵的计算工作区实现
+ * 功能描述:
+ * 1. 残差 r = (ln obs - ln cal) * 系数；理论值无效 (<= 1e-10) 或实测值无效的点残差为 0，与逐点追加的旧实现一致。
+ * 2. 双对数插值：网格上的理论值全为正时在 (ln t, ln y) 空间插值，插值结果直接就是 ln(理论值)；
+ *    含非正值时退回 (ln t, y) 插值 (与 CurveInterpolator::pchipLogLog 相同)。
+ * 3. 相对偏导 (dcal/dθ) / cal 在 (ln t, 值) 空间插值。
+ * 4. 各缓冲区只在长度变化时 (新的数据或网格) 重新分配。
+ */
+
+#include "fittingworkspace.h"
+#include "curveinterpolator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+const double kMinValue = 1e-10;
+const double kLogMinValue = std::log(kMinValue);
+const double kInvalidLog = -std::numeric_limits<double>::infinity();
+}
+
+void FittingWorkspace::setObservations(const QVector<double>& t, const QVector<double>& deltaP, const QVector<double>& derivative,
+                                       const QVector<double>& weightP, const QVector<double>& weightD, double weight)
+{
+    m_obsTime = t;
+    m_count = qMin(deltaP.size(), t.size());
+    m_dCount = qMin(derivative.size(), m_count);
+
+    m_logObsP.resize(m_count);
+    m_scaleP.resize(m_count);
+    for (int i = 0; i < m_count; ++i) {
+        bool valid = deltaP[i] > kMinValue;
+        m_logObsP[i] = valid ? std::log(deltaP[i]) : 0.0;
+        m_scaleP[i] = valid ? weight * (i < weightP.size() ? weightP[i] : 1.0) : 0.0;
+    }
+    m_logObsD.resize(m_dCount);
+    m_scaleD.resize(m_dCount);
+    for (int i = 0; i < m_dCount; ++i) {
+        bool valid = derivative[i] > kMinValue;
+        m_logObsD[i] = valid ? std::log(derivative[i]) : 0.0;
+        m_scaleD[i] = valid ? (1.0 - weight) * (i < weightD.size() ? weightD[i] : 1.0) : 0.0;
+    }
+
+    m_logP.resize(m_count);
+    m_logD.resize(m_dCount);
+    m_relP.resize(m_count);
+    m_relD.resize(m_dCount);
+    m_r.resize(m_count + m_dCount);
+    setGrid(QVector<double>());
+}
+
+void FittingWorkspace::setGrid(const QVector<double>& grid)
+{
+    m_grid = grid;
+    int m = grid.size();
+    if (m < 2) {
+        m_grid.clear();
+        m_logGrid.clear();
+        m_segment.clear();
+        m_basis.clear();
+        return;
+    }
+
+    m_logGrid.resize(m);
+    for (int k = 0; k < m; ++k) m_logGrid[k] = std::log(grid[k]);
+
+    // 各观测点的区间与 Hermite 基函数 (超出网格的点取端点值)
+    int n = m_obsTime.size();
+    m_segment.resize(n);
+    m_basis.resize(4 * n);
+    for (int i = 0; i < n; ++i) {
+        double x = m_obsTime[i] > 0.0 ? std::log(m_obsTime[i]) : m_logGrid[0];
+        int seg;
+        double s;
+        if (x <= m_logGrid[0]) {
+            seg = 0;
+            s = 0.0;
+        } else if (x >= m_logGrid[m - 1]) {
+            seg = m - 2;
+            s = 1.0;
+        } else {
+            seg = int(std::upper_bound(m_logGrid.constBegin(), m_logGrid.constEnd(), x) - m_logGrid.constBegin()) - 1;
+            s = (x - m_logGrid[seg]) / (m_logGrid[seg + 1] - m_logGrid[seg]);
+        }
+        double h = m_logGrid[seg + 1] - m_logGrid[seg];
+        double s2 = s * s;
+        double s3 = s2 * s;
+        m_segment[i] = seg;
+        m_basis[4 * i] = 2.0 * s3 - 3.0 * s2 + 1.0;
+        m_basis[4 * i + 1] = (s3 - 2.0 * s2 + s) * h;
+        m_basis[4 * i + 2] = -2.0 * s3 + 3.0 * s2;
+        m_basis[4 * i + 3] = (s3 - s2) * h;
+    }
+
+    m_nodeP.resize(m);
+    m_nodeD.resize(m);
+    m_slopes.resize(m);
+    m_relNode.resize(m);
+}
+
+void FittingWorkspace::interpolate(const double* y, double* out, int count)
+{
+    double* d = m_slopes.data();
+    CurveInterpolator::pchipSlopes(m_logGrid.constData(), y, m_logGrid.size(), d);
+    const int* segment = m_segment.constData();
+    const double* basis = m_basis.constData();
+    for (int i = 0; i < count; ++i) {
+        int k = segment[i];
+        const double* b = basis + 4 * i;
+        out[i] = b[0] * y[k] + b[1] * d[k] + b[2] * y[k + 1] + b[3] * d[k + 1];
+    }
+}
+
+bool FittingWorkspace::curveAtObservations(const ModelCurveData& curve)
+{
+    const QVector<double>& p = std::get<1>(curve);
+    const QVector<double>& d = std::get<2>(curve);
+    int size = fitTimes().size();
+    if (p.size() != size || d.size() != size) return false;
+
+    // 1. 直接在观测时间上计算
+    if (m_grid.isEmpty()) {
+        for (int i = 0; i < m_count; ++i) m_logP[i] = p[i] > kMinValue ? std::log(p[i]) : kInvalidLog;
+        for (int i = 0; i < m_dCount; ++i) m_logD[i] = d[i] > kMinValue ? std::log(d[i]) : kInvalidLog;
+        return true;
+    }
+
+    // 2. 网格上的值插值到观测时间
+    auto toObservations = [this, size](const QVector<double>& values, QVector<double>& node, QVector<double>& logOut, int count) {
+        bool positive = true;
+        for (int k = 0; k < size && positive; ++k) positive = values[k] > 0.0;
+        double* nodeData = node.data();
+        double* out = logOut.data();
+        if (positive) {
+            for (int k = 0; k < size; ++k) nodeData[k] = std::log(values[k]);
+            interpolate(nodeData, out, count);
+            for (int i = 0; i < count; ++i) {
+                if (!(out[i] > kLogMinValue)) out[i] = kInvalidLog;
+            }
+        } else {
+            for (int k = 0; k < size; ++k) nodeData[k] = values[k];
+            interpolate(nodeData, out, count);
+            for (int i = 0; i < count; ++i) out[i] = out[i] > kMinValue ? std::log(out[i]) : kInvalidLog;
+        }
+    };
+    toObservations(p, m_nodeP, m_logP, m_count);
+    if (m_dCount > 0) toObservations(d, m_nodeD, m_logD, m_dCount);
+    return true;
+}
+
+bool FittingWorkspace::residuals(const ModelCurveData& curve, Eigen::VectorXd& r)
+{
+    if (!curveAtObservations(curve)) return false;
+    m_lastCurve = curve;
+
+    r.resize(m_count + m_dCount);
+    for (int i = 0; i < m_count; ++i)
+        r(i) = (m_scaleP[i] != 0.0 && m_logP[i] != kInvalidLog) ? (m_logObsP[i] - m_logP[i]) * m_scaleP[i] : 0.0;
+    for (int i = 0; i < m_dCount; ++i)
+        r(m_count + i) = (m_scaleD[i] != 0.0 && m_logD[i] != kInvalidLog) ? (m_logObsD[i] - m_logD[i]) * m_scaleD[i] : 0.0;
+    return true;
+}
+
+double FittingWorkspace::sumSquares(const ModelCurveData& curve)
+{
+    if (!residuals(curve, m_r)) return std::numeric_limits<double>::infinity();
+    return m_r.squaredNorm();
+}
+
+bool FittingWorkspace::beginJacobian(const ModelCurveData& curve)
+{
+    // 共享曲线数据 (隐式共享，不复制)
+    m_pNode = std::get<1>(curve);
+    m_dNode = std::get<2>(curve);
+    return curveAtObservations(curve);
+}
+
+void FittingWorkspace::jacobianColumn(const QVector<double>& dP, const QVector<double>& dDeriv, double chain, int column, Eigen::MatrixXd& J)
+{
+    int size = fitTimes().size();
+    if (J.rows() != m_count + m_dCount || dP.size() != size || dDeriv.size() != size || m_pNode.size() != size || m_dNode.size() != size)
+        return;
+
+    // 相对偏导 (dcal/dθ) / cal，使用网格时先在网格上计算再插值
+    auto relative = [&](const QVector<double>& derivative, const QVector<double>& node, QVector<double>& out, int count) {
+        if (m_grid.isEmpty()) {
+            for (int i = 0; i < count; ++i) out[i] = node[i] > kMinValue ? derivative[i] / node[i] : 0.0;
+            return;
+        }
+        double* rel = m_relNode.data();
+        for (int k = 0; k < size; ++k) rel[k] = node[k] > kMinValue ? derivative[k] / node[k] : 0.0;
+        interpolate(rel, out.data(), count);
+    };
+    relative(dP, m_pNode, m_relP, m_count);
+    relative(dDeriv, m_dNode, m_relD, m_dCount);
+
+    // dr/dθ = -系数 * (dcal/dθ) / cal，被屏蔽的残差偏导为 0
+    for (int i = 0; i < m_count; ++i)
+        J(i, column) = (m_scaleP[i] != 0.0 && m_logP[i] != kInvalidLog) ? -m_scaleP[i] * m_relP[i] * chain : 0.0;
+    for (int i = 0; i < m_dCount; ++i)
+        J(m_count + i, column) = (m_scaleD[i] != 0.0 && m_logD[i] != kInvalidLog) ? -m_scaleD[i] * m_relD[i] * chain : 0.0;
+}
@@ -0,0 +1,80 @@
+/*
+ * fittingworkspace.h
+ * 文件作用: 拟合残差与雅可比矩阵的计算工作区头文件
+ * 功能描述:
+ * 1. 每次拟合开始时按观测数据一次算好实测值的对数、有效点掩码与各残差的权重系数 (压差/导数权重 × 观测点权重)。
+ * 2. 使用配点网格时，一次算好各观测点所在的网格区间与 Hermite 基函数系数，之后每次插值只做乘加。
+ * 3. 残差、插值结果、相对偏导等缓冲区由工作区持有，长度不变时反复使用，稳定迭代阶段不分配内存。
+ * 4. 工作区不是线程安全的：并发的起点或线程各自持有一份拷贝 (拷贝共享只读的观测部分)。
+ * 5. 记住最近一次算残差所用的理论曲线，界面刷新直接显示它，不再为显示单独计算一次。
+ */
+
+#ifndef FITTINGWORKSPACE_H
+#define FITTINGWORKSPACE_H
+
+#include "modelsolver01-06.h"
+
+#include <Eigen/Dense>
+#include <QVector>
+
+class FittingWorkspace
+{
+public:
+    // 按观测数据建立 (t、deltaP 等长；derivative、weightP、weightD 可为空)，weight 为压差残差的权重
+    void setObservations(const QVector<double>& t, const QVector<double>& deltaP, const QVector<double>& derivative,
+                         const QVector<double>& weightP, const QVector<double>& weightD, double weight);
+    // 配点网格 (严格递增的正值；为空时直接在观测时间上计算)
+    void setGrid(const QVector<double>& grid);
+
+    // 理论曲线的计算时间 (配点网格或观测时间)
+    const QVector<double>& fitTimes() const { return m_grid.isEmpty() ? m_obsTime : m_grid; }
+    int residualCount() const { return m_count + m_dCount; }
+
+    // 由 fitTimes() 上的理论曲线写出残差；曲线长度不符 (计算被取消) 时返回 false
+    bool residuals(const ModelCurveData& curve, Eigen::VectorXd& r);
+    // 同上，返回残差平方和 (不符时为 +inf)，残差写入内部缓冲区
+    double sumSquares(const ModelCurveData& curve);
+    // 最近一次成功算出残差的理论曲线 (fitTimes() 上，隐式共享不复制)
+    const ModelCurveData& lastCurve() const { return m_lastCurve; }
+
+    // 雅可比矩阵：先由 fitTimes() 上的理论曲线 beginJacobian，再逐列给出该列参数的偏导 (chain 为迭代变量的链式系数)
+    bool beginJacobian(const ModelCurveData& curve);
+    void jacobianColumn(const QVector<double>& dP, const QVector<double>& dDeriv, double chain, int column, Eigen::MatrixXd& J);
+
+private:
+    // 网格节点值 y 插值到前 count 个观测点 (线性空间)
+    void interpolate(const double* y, double* out, int count);
+    // 网格上的理论曲线换算到观测点，写入 m_logP/m_logD (无效点为 -inf)
+    bool curveAtObservations(const ModelCurveData& curve);
+
+    // 观测部分 (拟合期间只读)
+    QVector<double> m_obsTime;
+    int m_count = 0;                    // 压差残差个数
+    int m_dCount = 0;                   // 导数残差个数
+    QVector<double> m_logObsP;          // ln(实测压差)
+    QVector<double> m_logObsD;
+    QVector<double> m_scaleP;           // 残差系数 (无效实测点为 0)
+    QVector<double> m_scaleD;
+
+    // 配点网格与插值表
+    QVector<double> m_grid;
+    QVector<double> m_logGrid;
+    QVector<int> m_segment;             // 观测点所在网格区间
+    QVector<double> m_basis;            // 每个观测点 4 个系数: h00, h10*h, h01, h11*h
+
+    // 可复用缓冲区
+    QVector<double> m_nodeP;            // 网格上的 ln p (或 p，含非正值时)
+    QVector<double> m_nodeD;
+    QVector<double> m_slopes;
+    QVector<double> m_pNode;            // beginJacobian 时网格上的理论值
+    QVector<double> m_dNode;
+    QVector<double> m_relNode;          // 网格上的相对偏导
+    QVector<double> m_relP;             // 观测点上的相对偏导
+    QVector<double> m_relD;
+    QVector<double> m_logP;             // 观测点上的 ln(理论值)
+    QVector<double> m_logD;
+    Eigen::VectorXd m_r;
+    ModelCurveData m_lastCurve;
+};
+
+#endif // FITTINGWORKSPACE_H
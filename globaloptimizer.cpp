@@ -0,0 +1,165 @@
+/*
+ * globaloptimizer.cpp
+ * 文件作用: 多起点全局拟合实现
+ * 功能描述:
+ * 1. 各起点通过 QtConcurrent::blockingMap 在全局线程池中并发运行 (与求解器的计算线程池分开)，
+ *    调用者应让每个起点的求解上下文不再并行展开，避免线程数翻倍。
+ * 2. 当前最优残差平方和在每个起点每轮迭代开始时更新 (加锁)，剪枝判定读取的是所有起点迄今见过的最小值。
+ * 3. 剪枝条件：迭代轮数达到窗口长度，残差平方和超过当前最优的 pruneFactor 倍，
+ *    且最近一个窗口内只下降到窗口起点的 pruneProgress 倍以上。
+ */
+
+#include "globaloptimizer.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtConcurrent>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+GlobalOptimizer::Matrix GlobalOptimizer::latinHypercube(int count, const Vector& lower, const Vector& upper, unsigned int seed)
+{
+    const int dim = int(lower.size());
+    Matrix points(qMax(count, 0), dim);
+    if (count <= 0) return points;
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<int> strata(count);
+    for (int d = 0; d < dim; ++d) {
+        std::iota(strata.begin(), strata.end(), 0);
+        std::shuffle(strata.begin(), strata.end(), rng);
+        for (int i = 0; i < count; ++i) {
+            double u = (strata[i] + uniform(rng)) / count;
+            points(i, d) = lower(d) + u * (upper(d) - lower(d));
+        }
+    }
+    return points;
+}
+
+QVector<GlobalOptimizer::Solution> GlobalOptimizer::minimize(const ProblemFactory& factory, const Vector& initial,
+                                                             const Vector& sampleLower, const Vector& sampleUpper,
+                                                             const ProgressFunction& progress,
+                                                             const std::function<bool()>& cancelled)
+{
+    m_total = LMOptimizer::Statistics();
+    m_pruned = 0;
+    const double inf = std::numeric_limits<double>::infinity();
+    const int total = qMax(1, m_options.starts);
+    const int dim = int(initial.size());
+    if (dim == 0 || !factory) return QVector<Solution>();
+
+    Matrix samples = latinHypercube(total - 1, sampleLower, sampleUpper, m_options.seed);
+
+    // 共享状态：bestSse 为所有起点迭代中见过的最小值 (剪枝用)，bestX/bestFinishedSse 为已结束起点中的最优解 (进度显示用)
+    QMutex mutex;
+    double bestSse = inf;
+    double bestFinishedSse = inf;
+    Vector bestX = initial;
+    int finished = 0;
+
+    QVector<Solution> results(total);
+    QVector<int> starts(total);
+    std::iota(starts.begin(), starts.end(), 0);
+
+    QtConcurrent::blockingMap(starts, [&](int& s) {
+        Solution& solution = results[s];
+        solution.start = s;
+        solution.sse = inf;
+        if (cancelled && cancelled()) return;
+
+        Vector x = (s == 0) ? initial : Vector(samples.row(s - 1).transpose());
+        LMOptimizer::Problem problem = factory(s);
+
+        QVector<double> history;
+        std::function<bool(int, double)> callerContinue = problem.continueIteration;
+        problem.continueIteration = [&](int iter, double sse) {
+            if (callerContinue && !callerContinue(iter, sse)) return false;
+            history.append(sse);
+            double best;
+            {
+                QMutexLocker locker(&mutex);
+                bestSse = qMin(bestSse, sse);
+                best = bestSse;
+            }
+            if (s == 0 || iter < m_options.pruneWindow) return true;
+            double windowStart = history[iter - m_options.pruneWindow];
+            if (sse > m_options.pruneFactor * best && sse > m_options.pruneProgress * windowStart) {
+                solution.pruned = true;
+                return false;
+            }
+            return true;
+        };
+
+        LMOptimizer local(m_options.local);
+        local.minimize(problem, x);
+        solution.x = x;
+        solution.statistics = local.statistics();
+        if (solution.statistics.residualEvaluations > 0 && solution.statistics.stopReason != LMOptimizer::InvalidInput)
+            solution.sse = solution.statistics.finalSse;
+
+        Vector reportX;
+        double reportSse;
+        int reportFinished;
+        {
+            QMutexLocker locker(&mutex);
+            bestSse = qMin(bestSse, solution.sse);
+            if (!solution.pruned && solution.sse < bestFinishedSse) {
+                bestFinishedSse = solution.sse;
+                bestX = x;
+            }
+            reportFinished = ++finished;
+            reportX = bestX;
+            reportSse = bestFinishedSse;
+        }
+        if (progress) progress(reportFinished, total, reportX, reportSse);
+    });
+
+    // 汇总统计
+    for (const Solution& solution : results) {
+        const LMOptimizer::Statistics& st = solution.statistics;
+        m_total.iterations += st.iterations;
+        m_total.residualEvaluations += st.residualEvaluations;
+        m_total.jacobianEvaluations += st.jacobianEvaluations;
+        m_total.broydenUpdates += st.broydenUpdates;
+        m_total.rejectedSteps += st.rejectedSteps;
+        m_total.speculativeRounds += st.speculativeRounds;
+        m_total.geodesicSteps += st.geodesicSteps;
+        if (solution.pruned) ++m_pruned;
+    }
+    m_total.residualCount = results[0].statistics.residualCount;
+    m_total.initialSse = results[0].statistics.initialSse;
+    m_total.stopReason = (cancelled && cancelled()) ? LMOptimizer::Cancelled : LMOptimizer::Converged;
+
+    // 排序并合并重复解
+    QVector<Solution> ranked;
+    for (const Solution& solution : results) {
+        if (!solution.pruned && std::isfinite(solution.sse)) ranked.append(solution);
+    }
+    std::stable_sort(ranked.begin(), ranked.end(), [](const Solution& a, const Solution& b) { return a.sse < b.sse; });
+
+    QVector<Solution> distinct;
+    for (const Solution& candidate : ranked) {
+        bool duplicate = false;
+        for (const Solution& kept : distinct) {
+            bool close = true;
+            for (int d = 0; d < dim && close; ++d) {
+                double width = sampleUpper(d) - sampleLower(d);
+                if (!(width > 0.0) || !std::isfinite(width)) width = 1.0;
+                close = std::abs(candidate.x(d) - kept.x(d)) < m_options.distinctTolerance * width;
+            }
+            if (close) {
+                duplicate = true;
+                break;
+            }
+        }
+        if (!duplicate) distinct.append(candidate);
+        if (distinct.size() >= m_options.topK) break;
+    }
+    if (!distinct.isEmpty()) m_total.finalSse = distinct.first().sse;
+    return distinct;
+}
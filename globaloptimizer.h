@@ -0,0 +1,79 @@
+/*
+ * globaloptimizer.h
+ * 文件作用: 多起点全局拟合头文件
+ * 功能描述:
+ * 1. 在采样范围内按拉丁超立方生成起点 (每一维分成等概率的若干层，每层恰好一个起点)，
+ *    调用者给出的初始点固定作为第 0 个起点。
+ * 2. 各起点独立运行 LMOptimizer，并发分布在全局线程池的所有核心上；
+ *    每个起点的残差与雅可比回调由调用者的工厂函数单独创建 (各自持有求解缓冲区)，互不共享可变状态。
+ * 3. 所有起点共享当前最优残差平方和。某起点迭代若干轮后仍远高于当前最优、且最近几轮下降缓慢，则提前终止 (剪枝)；
+ *    第 0 个起点不剪枝，保证结果不差于单起点拟合。
+ * 4. 结果按残差平方和排序，合并迭代空间中相距很近的重复解后返回前 topK 个供分析人员选择。
+ * 5. 与 LMOptimizer 一样只负责迭代，不关心模型含义。
+ */
+
+#ifndef GLOBALOPTIMIZER_H
+#define GLOBALOPTIMIZER_H
+
+#include "lmoptimizer.h"
+
+#include <QVector>
+#include <functional>
+
+class GlobalOptimizer
+{
+public:
+    using Vector = LMOptimizer::Vector;
+    using Matrix = LMOptimizer::Matrix;
+
+    // 为第 start 个起点创建问题 (可在任意线程调用)；lower/upper 仍为迭代变量的硬边界
+    using ProblemFactory = std::function<LMOptimizer::Problem(int start)>;
+    // 某个起点结束后调用 (可在任意线程调用)：finished 为已结束的起点数
+    using ProgressFunction = std::function<void(int finished, int total, const Vector& bestX, double bestSse)>;
+
+    struct Options {
+        int starts = 16;                // 起点总数 (含初始点)
+        int topK = 5;                   // 返回的解个数
+        unsigned int seed = 20250519u;  // 拉丁超立方随机种子 (固定种子使结果可复现)
+        int pruneWindow = 4;            // 剪枝判定使用的迭代窗口
+        double pruneFactor = 10.0;      // 残差平方和超过当前最优的倍数
+        double pruneProgress = 0.5;     // 最近 pruneWindow 轮下降后仍大于起点值的此比例视为进展缓慢
+        double distinctTolerance = 0.01;    // 各维差异均小于采样宽度的此比例时视为同一个解
+        LMOptimizer::Options local;     // 各起点的 LM 设置
+    };
+
+    struct Solution {
+        Vector x;
+        double sse = 0.0;
+        int start = 0;                  // 起点编号 (0 为初始点)
+        bool pruned = false;
+        LMOptimizer::Statistics statistics;
+    };
+
+    GlobalOptimizer() = default;
+    explicit GlobalOptimizer(const Options& options) : m_options(options) {}
+
+    void setOptions(const Options& options) { m_options = options; }
+    const Options& options() const { return m_options; }
+
+    // 从 initial 与 [sampleLower, sampleUpper] 内的拉丁超立方起点出发并发拟合，返回排序去重后的前 topK 个解
+    // (被剪枝的起点不参与排序)。cancelled 返回 true 时未开始的起点不再运行
+    QVector<Solution> minimize(const ProblemFactory& factory, const Vector& initial,
+                               const Vector& sampleLower, const Vector& sampleUpper,
+                               const ProgressFunction& progress = ProgressFunction(),
+                               const std::function<bool()>& cancelled = std::function<bool()>());
+
+    // 全部起点的统计之和 (minimize 返回后有效)
+    const LMOptimizer::Statistics& totalStatistics() const { return m_total; }
+    int prunedStarts() const { return m_pruned; }
+
+    // 拉丁超立方采样：返回 count 行，每行一个点
+    static Matrix latinHypercube(int count, const Vector& lower, const Vector& upper, unsigned int seed);
+
+private:
+    Options m_options;
+    LMOptimizer::Statistics m_total;
+    int m_pruned = 0;
+};
+
+#endif // GLOBALOPTIMIZER_H
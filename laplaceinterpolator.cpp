@@ -0,0 +1,183 @@
+/*
+ * laplaceinterpolator.cpp
+ * 文件作用: 拉普拉斯空间函数沿射线的插值缓存实现
+ * 功能描述:
+ * 1. 初始按每个对数周期 (ln 10) 一段划分，逐层二分细化，同一层的节点合并为一次批量计算；
+ *    段内目标点数不超过每段节点数 (Degree + 1) 时直接标记为逐点求解。
+ * 2. Chebyshev 系数由 Lobatto 节点值经离散余弦变换得到，求值使用 Clenshaw 递推。
+ * 3. 含非有限值的分段不插值，交由调用者逐点求解 (与逐点计算时的行为一致)。
+ */
+
+#include "laplaceinterpolator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+// Lobatto 节点 x_j = cos(j*pi/Degree) 及 DCT 用余弦表
+struct ChebyshevTables {
+    double nodes[LaplaceRayInterpolator::Degree + 1];
+    double cosTable[LaplaceRayInterpolator::Degree + 1][LaplaceRayInterpolator::Degree + 1];
+    ChebyshevTables() {
+        const int n = LaplaceRayInterpolator::Degree;
+        for (int j = 0; j <= n; ++j) {
+            nodes[j] = std::cos(j * M_PI / n);
+            for (int k = 0; k <= n; ++k) cosTable[k][j] = std::cos(j * k * M_PI / n);
+        }
+    }
+};
+
+const ChebyshevTables& tables()
+{
+    static const ChebyshevTables t;
+    return t;
+}
+
+bool isFiniteComplex(const std::complex<double>& v)
+{
+    return std::isfinite(v.real()) && std::isfinite(v.imag());
+}
+}
+
+void LaplaceRayInterpolator::clear()
+{
+    m_rays.clear();
+    m_evaluations = 0;
+}
+
+void LaplaceRayInterpolator::chebyshevCoefficients(const Complex* values, Complex* coeffs)
+{
+    const int n = Degree;
+    const ChebyshevTables& tab = tables();
+    for (int k = 0; k <= n; ++k) {
+        Complex sum = 0.5 * (values[0] * tab.cosTable[k][0] + values[n] * tab.cosTable[k][n]);
+        for (int j = 1; j < n; ++j) sum += values[j] * tab.cosTable[k][j];
+        coeffs[k] = sum * (2.0 / n);
+    }
+    coeffs[0] *= 0.5;
+    coeffs[n] *= 0.5;
+}
+
+void LaplaceRayInterpolator::build(const QVector<Complex>& directions, const QVector<QVector<double>>& targets,
+                                   const BatchEvaluator& evaluate, double relTol)
+{
+    clear();
+    int nRays = directions.size();
+    m_rays.resize(nRays);
+    const int np = Degree + 1;
+
+    // 待细化分段：[first, first + count) 为落在段内的目标点下标
+    struct Pending { int ray; double a; double b; int first; int count; };
+    QVector<Pending> pending;
+
+    // 分段内目标点数不超过 np 时逐点求解更省，否则留待插值
+    auto schedule = [&](QVector<Pending>& list, int ray, double a, double b) {
+        const QVector<double>& u = targets[ray];
+        int first = int(std::lower_bound(u.constBegin(), u.constEnd(), a) - u.constBegin());
+        int last = int(std::lower_bound(u.constBegin(), u.constEnd(), b) - u.constBegin());
+        if (b >= u.last()) last = u.size();
+        if (last - first <= np || b - a < 1e-9) {
+            Panel panel;
+            panel.a = a;
+            panel.b = b;
+            m_rays[ray].append(panel);
+        } else {
+            list.append(Pending{ray, a, b, first, last - first});
+        }
+    };
+
+    // 初始按每个对数周期一段划分
+    for (int r = 0; r < nRays; ++r) {
+        if (targets[r].isEmpty()) continue;
+        double a = targets[r].first();
+        double b = targets[r].last();
+        int count = qMax(1, (int)std::ceil((b - a) / std::log(10.0)));
+        double w = (b - a) / count;
+        for (int i = 0; i < count; ++i) schedule(pending, r, a + i * w, (i == count - 1) ? b : a + (i + 1) * w);
+    }
+
+    const ChebyshevTables& tab = tables();
+    QVector<double> scale(nRays, 0.0);
+
+    while (!pending.isEmpty()) {
+        // 1. 本层所有分段的节点一次批量计算
+        QVector<Complex> s(pending.size() * np);
+        for (int i = 0; i < pending.size(); ++i) {
+            const Pending& p = pending[i];
+            double c = 0.5 * (p.a + p.b);
+            double h = 0.5 * (p.b - p.a);
+            for (int j = 0; j < np; ++j) {
+                s[i * np + j] = directions[p.ray] * std::exp(c + h * tab.nodes[j]);
+            }
+        }
+        QVector<Complex> values(s.size());
+        evaluate(s, values);
+        m_evaluations += s.size();
+
+        for (int i = 0; i < pending.size(); ++i) {
+            for (int j = 0; j < np; ++j) {
+                const Complex& v = values[i * np + j];
+                if (isFiniteComplex(v)) scale[pending[i].ray] = qMax(scale[pending[i].ray], std::abs(v));
+            }
+        }
+
+        // 2. 逐段判定：末两项系数足够小则接受，含非有限值的分段逐点求解，否则二分
+        QVector<Pending> next;
+        for (int i = 0; i < pending.size(); ++i) {
+            const Pending& p = pending[i];
+            Panel panel;
+            panel.a = p.a;
+            panel.b = p.b;
+            chebyshevCoefficients(values.constData() + i * np, panel.coeffs);
+
+            double tail = qMax(std::abs(panel.coeffs[Degree - 1]), std::abs(panel.coeffs[Degree]));
+            if (!std::isfinite(tail)) {
+                m_rays[p.ray].append(panel);
+            } else if (tail <= relTol * scale[p.ray]) {
+                panel.interpolated = true;
+                m_rays[p.ray].append(panel);
+            } else {
+                double mid = 0.5 * (p.a + p.b);
+                schedule(next, p.ray, p.a, mid);
+                schedule(next, p.ray, mid, p.b);
+            }
+        }
+        pending = next;
+    }
+
+    for (QVector<Panel>& panels : m_rays) {
+        std::sort(panels.begin(), panels.end(), [](const Panel& x, const Panel& y) { return x.a < y.a; });
+    }
+}
+
+bool LaplaceRayInterpolator::value(int ray, double u, Complex& out) const
+{
+    if (ray < 0 || ray >= m_rays.size() || m_rays[ray].isEmpty()) return false;
+    const QVector<Panel>& panels = m_rays[ray];
+
+    // 最后一个 a <= u 的分段
+    int lo = 0;
+    int hi = panels.size() - 1;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if (panels[mid].a <= u) lo = mid;
+        else hi = mid - 1;
+    }
+    const Panel& p = panels[lo];
+    if (!p.interpolated || u < p.a || u > p.b) return false;
+
+    // Clenshaw 递推
+    double x = (2.0 * u - p.a - p.b) / (p.b - p.a);
+    Complex b1(0.0, 0.0), b2(0.0, 0.0);
+    for (int k = Degree; k >= 1; --k) {
+        Complex b0 = p.coeffs[k] + 2.0 * x * b1 - b2;
+        b2 = b1;
+        b1 = b0;
+    }
+    out = p.coeffs[0] + x * b1 - b2;
+    return true;
+}
@@ -0,0 +1,59 @@
+/*
+ * laplaceinterpolator.h
+ * 文件作用: 拉普拉斯空间函数沿射线的插值缓存头文件
+ * 功能描述:
+ * 1. 反演节点均为 s = alpha_m / t 的形式：固定 m 时，不同时间点的节点落在同一条射线 arg(s) = arg(alpha_m) 上，
+ *    只有模长 |s| 随 t 变化。Stehfest 的全部节点都在正实轴这一条射线上。
+ * 2. 在每条射线上以 u = ln|s| 为自变量，用自适应分段 Chebyshev 插值 (每段 Degree + 1 个 Lobatto 节点) 逼近被插值函数，
+ *    以末两项 Chebyshev 系数的模估计误差，超出容差的分段二分细化。
+ * 3. 细化按代价决策：分段内目标点数不超过继续细化所需的计算次数时，该段不再插值，由调用者逐点求解，
+ *    因此总计算次数不会明显超过逐点求解。
+ * 4. 同一细化层级的所有待计算节点一次性交给调用者批量计算 (调用者可并行)，再逐段判定是否接受。
+ * 5. 只负责插值，不关心被插值函数的含义；求解器传入 s*F(s) 以压缩动态范围。
+ */
+
+#ifndef LAPLACEINTERPOLATOR_H
+#define LAPLACEINTERPOLATOR_H
+
+#include <QVector>
+#include <complex>
+#include <functional>
+
+class LaplaceRayInterpolator
+{
+public:
+    using Complex = std::complex<double>;
+    // 批量计算接口: values[i] = g(s[i])
+    using BatchEvaluator = std::function<void(const QVector<Complex>& s, QVector<Complex>& values)>;
+
+    static const int Degree = 10;   // 每段插值多项式次数
+
+    // 构建插值：directions 为各射线方向 (单位复数)，targets[r] 为射线 r 上需要取值的 u = ln|s| (升序)，
+    // relTol 为相对于该射线上 |g| 最大值的误差容限
+    void build(const QVector<Complex>& directions, const QVector<QVector<double>>& targets,
+               const BatchEvaluator& evaluate, double relTol);
+
+    // 射线 ray 上 u 处的插值结果；u 落在放弃插值的分段 (或超出范围) 时返回 false
+    bool value(int ray, double u, Complex& out) const;
+
+    // 构建过程中调用 g 的总次数
+    int evaluations() const { return m_evaluations; }
+
+    void clear();
+
+private:
+    struct Panel {
+        double a = 0.0;
+        double b = 0.0;
+        bool interpolated = false;  // false 表示该段逐点求解
+        Complex coeffs[Degree + 1];
+    };
+
+    // 由 Lobatto 节点上的函数值求 Chebyshev 系数
+    static void chebyshevCoefficients(const Complex* values, Complex* coeffs);
+
+    QVector<QVector<Panel>> m_rays;   // 各射线的分段，按 a 递增且首尾相接
+    int m_evaluations = 0;
+};
+
+#endif // LAPLACEINTERPOLATOR_H
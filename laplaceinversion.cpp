@@ -0,0 +1,260 @@
+/*
+ * laplaceinversion.cpp
+ * 文件作用: 拉普拉斯数值反演引擎实现
+ * 功能描述:
+ * 1. Stehfest 权重以 long double 精度一次性计算，不再在每个时间点重复计算阶乘。
+ * 2. 固定 Talbot 方法 (Abate-Valko, 2004)：r = 2M/(5t)，节点 s(theta) = r*theta*(cot(theta) + i)。
+ * 3. de Hoog 方法 (de Hoog, Knight & Stokes, 1982)：对梯形公式的 Fourier 级数用商差 (QD) 算法
+ *    构造连分式加速收敛，取 T = 2t。
+ * 4. 三种方法的节点均可写成 alpha_k / t 的形式，节点表与时间无关，按 (方法, 阶数) 缓存。
+ * 5. de Hoog 商差算法按标量类型模板化，方向导数以单方向对偶数 (dualnumber.h) 沿同一算法求得。
+ */
+
+#include "laplaceinversion.h"
+#include "dualnumber.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+// de Hoog 方法的目标相对精度，决定节点实部 gamma = -ln(tol) / (2T)
+const double kDeHoogTolerance = 1e-12;
+
+long double factorialLD(int n)
+{
+    long double r = 1.0L;
+    for (int i = 2; i <= n; ++i) r *= i;
+    return r;
+}
+}
+
+// 获取节点/权重表 (首次使用时构建，此后只读共享)
+const LaplaceInversion::Table& LaplaceInversion::table(Method method, int order)
+{
+    static QMutex mutex;
+    static std::map<std::pair<int, int>, std::unique_ptr<Table>> cache;
+
+    order = normalizeOrder(method, order);
+    QMutexLocker locker(&mutex);
+    std::unique_ptr<Table>& slot = cache[std::make_pair((int)method, order)];
+    if (!slot) {
+        std::unique_ptr<Table> tab(new Table);
+        tab->method = method;
+        tab->order = order;
+        switch (method) {
+        case Talbot: buildTalbot(*tab); break;
+        case DeHoog: buildDeHoog(*tab); break;
+        case Stehfest:
+        default: buildStehfest(*tab); break;
+        }
+        slot = std::move(tab);
+    }
+    return *slot;
+}
+
+int LaplaceInversion::defaultOrder(Method method, bool highPrecision)
+{
+    switch (method) {
+    case Talbot: return highPrecision ? 12 : 8;
+    case DeHoog: return highPrecision ? 8 : 5;
+    case Stehfest:
+    default: return highPrecision ? 8 : 4;
+    }
+}
+
+int LaplaceInversion::normalizeOrder(Method method, int order)
+{
+    switch (method) {
+    case Talbot:
+        return qBound(4, order, 32);
+    case DeHoog:
+        return qBound(2, order, 30);
+    case Stehfest:
+    default:
+        // 与原有逻辑一致：奇数阶退回 N = 4；double 精度下 N 超过 20 时相消误差过大
+        if (order % 2 != 0 || order < 2) order = 4;
+        return qMin(order, 20);
+    }
+}
+
+QString LaplaceInversion::methodName(Method method)
+{
+    switch (method) {
+    case Talbot: return "固定 Talbot";
+    case DeHoog: return "de Hoog";
+    case Stehfest:
+    default: return "Stehfest";
+    }
+}
+
+// Stehfest: f(t) = ln2/t * sum(V_k * F(k*ln2/t))
+void LaplaceInversion::buildStehfest(Table& tab)
+{
+    int N = tab.order;
+    int half = N / 2;
+    double ln2 = std::log(2.0);
+    tab.complexNodes = false;
+    tab.nodes.resize(N);
+    tab.weights.resize(N);
+
+    for (int i = 1; i <= N; ++i) {
+        long double s = 0.0L;
+        int k1 = (i + 1) / 2;
+        int k2 = qMin(i, half);
+        for (int k = k1; k <= k2; ++k) {
+            long double num = std::pow((long double)k, (long double)half) * factorialLD(2 * k);
+            long double den = factorialLD(half - k) * factorialLD(k) * factorialLD(k - 1)
+                              * factorialLD(i - k) * factorialLD(2 * k - i);
+            if (den != 0.0L) s += num / den;
+        }
+        double V = (double)(((i + half) % 2 == 0) ? s : -s);
+        tab.nodes[i - 1] = Complex(i * ln2, 0.0);
+        tab.weights[i - 1] = Complex(ln2 * V, 0.0);
+    }
+}
+
+// 固定 Talbot: f(t) = r/M * [F(r)e^{rt}/2 + sum Re(e^{t*s_k} F(s_k) (1 + i*sigma_k))]
+void LaplaceInversion::buildTalbot(Table& tab)
+{
+    int M = tab.order;
+    double rho = 2.0 * M / 5.0;   // r * t
+    tab.complexNodes = true;
+    tab.nodes.resize(M);
+    tab.weights.resize(M);
+
+    tab.nodes[0] = Complex(rho, 0.0);
+    tab.weights[0] = Complex(0.5 * rho / M * std::exp(rho), 0.0);
+
+    for (int k = 1; k < M; ++k) {
+        double theta = k * M_PI / M;
+        double cot = std::cos(theta) / std::sin(theta);
+        Complex alpha = rho * theta * Complex(cot, 1.0);
+        double sigma = theta + (theta * cot - 1.0) * cot;
+        tab.nodes[k] = alpha;
+        tab.weights[k] = (rho / M) * std::exp(alpha) * Complex(1.0, sigma);
+    }
+}
+
+// de Hoog: 节点 p_k = gamma + i*k*pi/T，T = 2t，k = 0..2M
+void LaplaceInversion::buildDeHoog(Table& tab)
+{
+    int M = tab.order;
+    double gammaT = -std::log(kDeHoogTolerance) / 4.0; // gamma * t
+    tab.complexNodes = true;
+    tab.nodes.resize(2 * M + 1);
+    for (int k = 0; k <= 2 * M; ++k) {
+        tab.nodes[k] = Complex(gammaT, 0.5 * M_PI * k);
+    }
+    tab.weights.clear();
+    tab.scale = std::exp(gammaT) / 2.0;    // exp(gamma*t) / T 中与 t 无关的部分
+}
+
+double LaplaceInversion::invert(const Table& table, double t, const Complex* values)
+{
+    if (t <= 0.0) return 0.0;
+
+    if (table.method == DeHoog) {
+        return table.scale * deHoogFraction(table.order, values).real() / t;
+    }
+
+    double sum = 0.0;
+    int n = table.nodes.size();
+    for (int k = 0; k < n; ++k) {
+        sum += (table.weights[k] * values[k]).real();
+    }
+    return sum / t;
+}
+
+double LaplaceInversion::invertDerivative(const Table& table, double t, const Complex* values, const Complex* dvalues)
+{
+    if (t <= 0.0) return 0.0;
+
+    if (table.method == DeHoog) {
+        using DualComplex = Dual<Complex, 1>;
+        int n = table.nodes.size();
+        std::vector<DualComplex> fp(n);
+        for (int k = 0; k < n; ++k) {
+            fp[k].val = values[k];
+            fp[k].der[0] = dvalues[k];
+        }
+        return table.scale * deHoogFraction(table.order, fp.data()).der[0].real() / t;
+    }
+
+    // Stehfest、Talbot 为节点值的线性组合
+    return invert(table, t, dvalues);
+}
+
+// de Hoog 商差算法 (取 T = 2t，因此幂级数的底 z = exp(i*pi*t/T) = i)
+template<typename C>
+C LaplaceInversion::deHoogFraction(int M, const C* fp)
+{
+    using std::abs;
+    using std::sqrt;
+    int np = 2 * M + 1;
+    std::vector<C> e((size_t)np * (M + 1), C(0.0));
+    std::vector<C> q((size_t)2 * M * M, C(0.0));
+    auto E = [&](int i, int r) -> C& { return e[(size_t)i * (M + 1) + r]; };
+    auto Q = [&](int i, int r) -> C& { return q[(size_t)i * M + r]; };
+
+    if (abs(fp[0]) < 1e-300) return C(0.0);
+
+    // 初始化商差表第一列
+    Q(0, 0) = fp[1] / (fp[0] / 2.0);
+    for (int i = 1; i < 2 * M; ++i) {
+        if (abs(fp[i]) < 1e-300) return C(0.0);
+        Q(i, 0) = fp[i + 1] / fp[i];
+    }
+
+    // 菱形法则填充 e 与 q：第 r 列 e 有 2(M-r)+1 项，q 只有 2(M-r) 项 (下一列 e 与连分式用到的全部)，
+    // 因此只有实际用到的分母为零时才放弃该时间点
+    for (int r = 1; r <= M; ++r) {
+        int me = 2 * (M - r) + 1;
+        for (int i = 0; i < me; ++i) {
+            E(i, r) = Q(i + 1, r - 1) - Q(i, r - 1) + E(i + 1, r - 1);
+        }
+        if (r != M) {
+            for (int i = 0; i < me - 1; ++i) {
+                C den = E(i, r);
+                if (abs(den) < 1e-300) return C(0.0);
+                Q(i, r) = Q(i + 1, r - 1) * E(i + 1, r) / den;
+            }
+        }
+    }
+
+    // 连分式系数
+    std::vector<C> d(np);
+    d[0] = fp[0] / 2.0;
+    for (int r = 1; r <= M; ++r) {
+        d[2 * r - 1] = -Q(0, r - 1);
+        d[2 * r] = -E(0, r);
+    }
+
+    // 递推求 Pade 近似分子分母
+    const Complex z(0.0, 1.0);
+    std::vector<C> A(np + 1), B(np + 1);
+    A[0] = C(0.0);
+    A[1] = d[0];
+    B[0] = C(1.0);
+    B[1] = C(1.0);
+    for (int i = 1; i < 2 * M; ++i) {
+        A[i + 1] = A[i] + d[i] * A[i - 1] * z;
+        B[i + 1] = B[i] + d[i] * B[i - 1] * z;
+    }
+
+    // 改进余项
+    C brem = (1.0 + (d[2 * M - 1] - d[2 * M]) * z) / 2.0;
+    C rem = brem * (sqrt(1.0 + d[2 * M] * z / (brem * brem)) - 1.0);
+    A[np] = A[2 * M] + rem * A[2 * M - 1];
+    B[np] = B[2 * M] + rem * B[2 * M - 1];
+
+    if (abs(B[np]) < 1e-300) return C(0.0);
+    return A[np] / B[np];
+}
@@ -0,0 +1,71 @@
+/*
+ * laplaceinversion.h
+ * 文件作用: 拉普拉斯数值反演引擎头文件
+ * 功能描述:
+ * 1. 定义反演方法枚举 (Stehfest、固定 Talbot、de Hoog)。
+ * 2. 按 (方法, 阶数) 预计算并缓存归一化节点与权重表，各时间点、各次调用共享，线程安全。
+ * 3. 提供统一的反演接口：调用者在节点 s_k = nodes[k] / t 处计算拉普拉斯函数值，
+ *    再由本类组合得到时间域结果。
+ * 4. 纯数学计算，不依赖任何 UI 控件。
+ * 5. 提供反演结果对节点值的方向导数，供参数灵敏度计算使用。
+ */
+
+#ifndef LAPLACEINVERSION_H
+#define LAPLACEINVERSION_H
+
+#include <QVector>
+#include <QString>
+#include <complex>
+
+class LaplaceInversion
+{
+public:
+    using Complex = std::complex<double>;
+
+    // 反演方法
+    enum Method {
+        Stehfest = 0,   // Gaver-Stehfest 方法 (实数节点，只需实数拉普拉斯函数)
+        Talbot,         // 固定 Talbot 方法 (Abate-Valko，复数节点)
+        DeHoog          // de Hoog-Knight-Stokes 方法 (复数节点，商差算法加速)
+    };
+
+    // 预计算的节点/权重表
+    struct Table {
+        Method method = Stehfest;
+        int order = 0;                 // 阶数：Stehfest 为 N，Talbot 为节点数 M，de Hoog 为 M (共 2M+1 个节点)
+        bool complexNodes = false;     // 是否需要复数拉普拉斯函数
+        QVector<Complex> nodes;        // 归一化节点 alpha_k，实际节点 s_k = alpha_k / t
+        QVector<Complex> weights;      // 线性组合权重 w_k: f(t) = (1/t) * sum(Re(w_k * F(s_k)))，de Hoog 不使用
+        double scale = 1.0;            // de Hoog 方法的指数缩放因子 exp(gamma * t) / T 的归一化值
+    };
+
+    // 获取 (方法, 阶数) 对应的节点/权重表 (首次调用时计算并缓存，线程安全)
+    static const Table& table(Method method, int order);
+
+    // 根据精度模式给出各方法的默认阶数
+    static int defaultOrder(Method method, bool highPrecision);
+
+    // 将阶数规整到方法允许的范围内 (Stehfest 要求偶数)
+    static int normalizeOrder(Method method, int order);
+
+    // 由节点处的拉普拉斯函数值 values[k] = F(nodes[k] / t) 计算 f(t)
+    static double invert(const Table& table, double t, const Complex* values);
+
+    // 反演结果沿节点值变化方向 dvalues 的方向导数 (values 为当前节点值)：Stehfest、Talbot 等于对 dvalues 反演，
+    // de Hoog 的商差加速对节点值非线性，沿同一算法逐步求导
+    static double invertDerivative(const Table& table, double t, const Complex* values, const Complex* dvalues);
+
+    // 获取方法名称
+    static QString methodName(Method method);
+
+private:
+    static void buildStehfest(Table& tab);
+    static void buildTalbot(Table& tab);
+    static void buildDeHoog(Table& tab);
+
+    // de Hoog 商差算法求连分式并返回 A/B (C 为 Complex，求方向导数时为对偶数)
+    template<typename C>
+    static C deHoogFraction(int M, const C* values);
+};
+
+#endif // LAPLACEINVERSION_H
@@ -0,0 +1,256 @@
+/*
+ * lmoptimizer.cpp
+ * 文件作用: Levenberg-Marquardt 非线性最小二乘优化器实现
+ * 功能描述:
+ * 1. 缩放雅可比 Js = J * diag(1/sqrt(D)) 的奇异值分解 Js = U S V^T 给出阻尼步长
+ *    delta = -diag(1/sqrt(D)) * V * diag(s / (s^2 + lambda)) * U^T r，奇异值为零的方向自然被忽略，
+ *    不会像法方程那样因 J^T J 病态而失去精度。
+ * 2. 试探点逐分量截断到上下界，Broyden 修正与步长判定均使用截断后的实际步长。
+ * 3. 试探点残差长度与当前残差不一致 (求解失败) 时按被拒绝处理。
+ * 4. 投机阻尼的阻尼系数序列与逐次试探相同 (lambda、10 lambda、...)：第一个单独计算，被接受时与逐次试探完全一样；
+ *    被拒绝后其余的一次批量计算，取残差最小者，接受第 k 个时 lambda 更新为其阻尼系数的 1/10，
+ *    全部被拒绝时与逐次试探全部失败后相同。
+ * 5. 测地加速 (Transtrum & Sethna)：加速度 a 满足 (J^T J + lambda * D) a = -J^T r_vv，修正步长为 v + a/2；
+ *    r_vv 用第一个试探点的残差差分估计 (差分步长取 1)，不增加探测点，只多计算修正后的试探点一次。
+ */
+
+#include "lmoptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void LMOptimizer::factorize()
+{
+    const int nParams = int(m_J.cols());
+    for (int j = 0; j < nParams; ++j) {
+        m_columnScale(j) = 1.0 / std::sqrt(1.0 + m_J.col(j).squaredNorm());
+    }
+    m_scaledJ.noalias() = m_J * m_columnScale.asDiagonal();
+    m_svd.compute(m_scaledJ, Eigen::ComputeThinU | Eigen::ComputeThinV);
+    m_utr.noalias() = m_svd.matrixU().transpose() * m_r;
+}
+
+void LMOptimizer::solveDamped(double lambda, const Vector& utr, Vector& delta)
+{
+    const Vector& s = m_svd.singularValues();
+    m_z = utr;
+    for (int k = 0; k < s.size(); ++k) m_z(k) *= -s(k) / (s(k) * s(k) + lambda);
+    delta.noalias() = m_svd.matrixV() * m_z;
+    delta.array() *= m_columnScale.array();
+}
+
+void LMOptimizer::rememberGeodesicBase()
+{
+    // 须在 Broyden 修正之前调用 (修正后 J v 恰好等于 r(x + v) - r，二阶项被抹去)
+    m_velocity = m_step;
+    m_rvv.noalias() = m_J * m_step;
+    m_rvv = 2.0 * (m_rTrial - m_r - m_rvv);
+}
+
+bool LMOptimizer::broydenUpdate()
+{
+    double stepNorm2 = m_step.squaredNorm();
+    if (stepNorm2 < 1e-30) return false; // 步长被上下界截断为零，没有割线信息
+
+    m_predicted.noalias() = m_J * m_step;
+    m_predicted = (m_rTrial - m_r - m_predicted) / stepNorm2;
+    m_J.noalias() += m_predicted * m_step.transpose();
+    return true;
+}
+
+LMOptimizer::StopReason LMOptimizer::minimize(const Problem& problem, Vector& x)
+{
+    m_stats = Statistics();
+    const int nParams = int(x.size());
+    if (nParams == 0 || !problem.residuals || !problem.jacobian) return m_stats.stopReason = InvalidInput;
+
+    // 1. 初始残差 (确定残差长度)
+    if (!problem.residuals(x, m_r)) return m_stats.stopReason = Cancelled;
+    ++m_stats.residualEvaluations;
+    const int nRes = int(m_r.size());
+    m_stats.residualCount = nRes;
+    if (nRes == 0) return m_stats.stopReason = InvalidInput;
+
+    double sse = m_r.squaredNorm();
+    m_stats.initialSse = sse;
+    m_stats.finalSse = sse;
+
+    m_J.resize(nRes, nParams);
+    m_rTrial.resize(nRes);
+    m_xTrial.resize(nParams);
+    m_step.resize(nParams);
+    m_columnScale.resize(nParams);
+
+    const int tries = std::max(1, m_options.maxDampingTries);
+    const bool speculative = m_options.speculativeDamping && bool(problem.batchResiduals) && tries > 1;
+    if (speculative) {
+        m_X.resize(nParams, tries - 1);
+        m_R.resize(nRes, tries - 1);
+    }
+
+    Vector lower = problem.lower.size() == nParams ? problem.lower : Vector::Constant(nParams, -std::numeric_limits<double>::infinity());
+    Vector upper = problem.upper.size() == nParams ? problem.upper : Vector::Constant(nParams, std::numeric_limits<double>::infinity());
+
+    double lambda = m_options.initialLambda;
+    bool refreshJacobian = true;
+    int sinceRefresh = 0;
+    m_stats.stopReason = MaxIterations;
+
+    for (int iter = 0; iter < m_options.maxIterations; ++iter) {
+        if (sse / nRes < m_options.targetMse) {
+            m_stats.stopReason = Converged;
+            break;
+        }
+        if (problem.continueIteration && !problem.continueIteration(iter, sse)) {
+            m_stats.stopReason = Stopped;
+            break;
+        }
+        if (problem.iterationStarted) problem.iterationStarted(iter, sse);
+        m_stats.iterations = iter + 1;
+
+        // 2. 完整计算或沿用 (Broyden 修正后的) 雅可比矩阵
+        if (!m_options.broydenUpdate || refreshJacobian || sinceRefresh >= m_options.jacobianRefresh) {
+            if (!problem.jacobian(x, m_r, m_J)) {
+                m_stats.stopReason = Cancelled;
+                break;
+            }
+            ++m_stats.jacobianEvaluations;
+            refreshJacobian = false;
+            sinceRefresh = 0;
+        }
+        bool freshJacobian = (sinceRefresh == 0);
+        ++sinceRefresh;
+        double startSse = sse;
+        double startLambda = lambda;
+
+        factorize();
+
+        // 3. 阻尼试探：同一分解下只改变 lambda
+        bool stepAccepted = false;
+        bool cancelled = false;
+        bool geodesicBase = false;
+        m_xStart = x;
+        for (int tryIter = 0; tryIter < tries; ++tryIter) {
+            if (speculative && tryIter == 1) {
+                // 3b. 投机阻尼：第一个阻尼系数被拒绝后，其余阻尼系数一次批量计算，取残差最小者
+                const int rest = tries - 1;
+                for (int k = 0; k < rest; ++k) {
+                    solveDamped(lambda * std::pow(10.0, k), m_utr, m_delta);
+                    m_X.col(k) = (x + m_delta).cwiseMax(lower).cwiseMin(upper);
+                }
+                if (!problem.batchResiduals(m_X, m_R)) {
+                    cancelled = true;
+                    break;
+                }
+                m_stats.residualEvaluations += rest;
+                ++m_stats.speculativeRounds;
+                int best = -1;
+                double bestSse = sse;
+                for (int k = 0; k < rest; ++k) {
+                    m_step = m_X.col(k) - x;
+                    m_rTrial = m_R.col(k);
+                    double trialSse = m_rTrial.squaredNorm();
+                    bool valid = std::isfinite(trialSse);
+                    if (m_options.broydenUpdate && valid && broydenUpdate()) ++m_stats.broydenUpdates;
+                    if (valid && trialSse < bestSse) {
+                        best = k;
+                        bestSse = trialSse;
+                    }
+                    if (!(valid && trialSse < sse)) ++m_stats.rejectedSteps;
+                }
+                if (best >= 0) {
+                    x = m_X.col(best);
+                    m_r = m_R.col(best);
+                    sse = bestSse;
+                    lambda *= std::pow(10.0, best - 1);
+                    stepAccepted = true;
+                } else {
+                    lambda *= std::pow(10.0, rest);
+                }
+                break;
+            }
+
+            // 3a. 逐次试探：被拒绝时增大阻尼系数再试 (投机模式下只有第一个阻尼系数走这里，它通常即被接受)
+            solveDamped(lambda, m_utr, m_delta);
+            m_xTrial = (x + m_delta).cwiseMax(lower).cwiseMin(upper);
+            m_step = m_xTrial - x;
+
+            if (!problem.residuals(m_xTrial, m_rTrial)) {
+                cancelled = true;
+                break;
+            }
+            ++m_stats.residualEvaluations;
+
+            bool valid = (m_rTrial.size() == nRes);
+            double trialSse = valid ? m_rTrial.squaredNorm() : std::numeric_limits<double>::infinity();
+            if (tryIter == 0 && std::isfinite(trialSse) && m_options.geodesicAcceleration) {
+                rememberGeodesicBase();
+                geodesicBase = true;
+            }
+
+            // 被拒绝的试探点同样给出当前点沿 step 方向的割线信息
+            if (m_options.broydenUpdate && valid && broydenUpdate()) ++m_stats.broydenUpdates;
+
+            if (trialSse < sse) {
+                x = m_xTrial;
+                m_r.swap(m_rTrial);
+                m_rTrial.resize(nRes);
+                sse = trialSse;
+                lambda /= 10.0;
+                stepAccepted = true;
+                break;
+            }
+            lambda *= 10.0;
+            ++m_stats.rejectedSteps;
+        }
+
+        // 4. 测地加速：以第一个阻尼系数的步长 v 为基础，修正为 v + a/2，比本轮已有结果更好时采用
+        if (!cancelled && geodesicBase) {
+            m_utrvv.noalias() = m_svd.matrixU().transpose() * m_rvv;
+            solveDamped(startLambda, m_utrvv, m_acceleration);
+            double velocityNorm = m_velocity.norm();
+            if (velocityNorm > 0.0 && 2.0 * m_acceleration.norm() <= m_options.geodesicRatio * velocityNorm) {
+                m_xTrial = (m_xStart + m_velocity + 0.5 * m_acceleration).cwiseMax(lower).cwiseMin(upper);
+                if (!problem.residuals(m_xTrial, m_rTrial)) {
+                    cancelled = true;
+                } else {
+                    ++m_stats.residualEvaluations;
+                    double trialSse = (m_rTrial.size() == nRes) ? m_rTrial.squaredNorm() : std::numeric_limits<double>::infinity();
+                    if (trialSse < sse) {
+                        x = m_xTrial;
+                        m_r.swap(m_rTrial);
+                        m_rTrial.resize(nRes);
+                        sse = trialSse;
+                        lambda = startLambda / 10.0;
+                        stepAccepted = true;
+                        ++m_stats.geodesicSteps;
+                    }
+                }
+            }
+        }
+        if (cancelled) {
+            m_stats.stopReason = Cancelled;
+            break;
+        }
+        if (stepAccepted && problem.stepAccepted) problem.stepAccepted(x, sse);
+
+        if (m_options.broydenUpdate && !freshJacobian) {
+            // 修正后的雅可比矩阵已不可靠：恢复阻尼系数，下一轮完整重算
+            if (!stepAccepted) {
+                lambda = startLambda;
+                refreshJacobian = true;
+                continue;
+            }
+            if (sse > 0.99 * startSse) refreshJacobian = true;
+        }
+        if (!stepAccepted && lambda > m_options.maxLambda) {
+            m_stats.stopReason = DampingLimit;
+            break;
+        }
+    }
+
+    m_stats.finalSse = sse;
+    m_stats.finalLambda = lambda;
+    return m_stats.stopReason;
+}
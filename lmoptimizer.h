@@ -0,0 +1,135 @@
+/*
+ * lmoptimizer.h
+ * 文件作用: Levenberg-Marquardt 非线性最小二乘优化器头文件
+ * 功能描述:
+ * 1. 只负责迭代本身，不关心模型含义：残差、雅可比矩阵由调用者通过回调计算，迭代变量的上下界在迭代空间给出。
+ * 2. 残差、雅可比矩阵与各中间量均为连续存储的 Eigen 矩阵/向量，保存在优化器内部的工作区中，
+ *    迭代过程中不再分配内存；回调直接写入工作区。
+ * 3. 阻尼方程 (J^T J + lambda * D) delta = -J^T r 不显式构造法方程：对列缩放后的雅可比矩阵 J D^(-1/2)
+ *    做一次奇异值分解，同一雅可比矩阵下的各次阻尼试探只需 O(n^2) 的回代。D 取 1 + |J 的列|^2，与原拟合流程的阻尼一致。
+ * 4. 可选 Broyden 秩一修正：两次完整计算之间用试探点残差修正雅可比矩阵，
+ *    每隔若干轮、步长全部被拒绝或下降不足时重新完整计算。
+ * 5. 记录迭代统计 (迭代次数、残差与雅可比计算次数、Broyden 修正次数、被拒绝步数、停止原因)。
+ * 6. 调用者可通过 continueIteration 回调按残差轨迹提前终止迭代 (多起点拟合的剪枝)。
+ * 7. 可选投机阻尼：第一个阻尼系数照常单独计算；被拒绝后其余阻尼系数的试探点由批量残差回调并发计算，取残差最小者，
+ *    步长被拒绝的迭代只多花一轮并行计算，而不是依次最多 maxDampingTries - 1 次；步长被接受的迭代不多算。
+ * 8. 可选测地加速：用第一个试探点的残差估计残差沿步长方向的二阶变化，给出二阶修正后的步长再计算一次，更好时采用。
+ */
+
+#ifndef LMOPTIMIZER_H
+#define LMOPTIMIZER_H
+
+#include <Eigen/Dense>
+#include <functional>
+
+class LMOptimizer
+{
+public:
+    using Vector = Eigen::VectorXd;
+    using Matrix = Eigen::MatrixXd;
+
+    // 残差回调: 由迭代变量 x 计算残差 r (长度在整个优化过程中不变)；返回 false 表示被取消或计算失败
+    using ResidualFunction = std::function<bool(const Vector& x, Vector& r)>;
+    // 雅可比回调: J(i, j) = dr_i/dx_j，J 已按 (残差数 × 参数数) 分配好；r 为 x 处的残差
+    using JacobianFunction = std::function<bool(const Vector& x, const Vector& r, Matrix& J)>;
+    // 批量残差回调: X 的每列为一个试探点，R 已按 (残差数 × 列数) 分配；某列计算失败时该列写入 NaN
+    using BatchResidualFunction = std::function<bool(const Matrix& X, Matrix& R)>;
+
+    struct Options {
+        int maxIterations = 50;
+        int maxDampingTries = 5;        // 每轮最多尝试的阻尼系数个数
+        double initialLambda = 0.01;
+        double maxLambda = 1e10;        // 本轮步长全部被拒绝且阻尼系数超过此值时停止
+        double targetMse = 3e-3;        // 均方残差低于此值视为收敛
+        bool broydenUpdate = false;     // 两次完整计算之间用 Broyden 秩一修正雅可比矩阵
+        int jacobianRefresh = 5;        // Broyden 模式下完整计算雅可比矩阵的间隔轮数
+        bool speculativeDamping = false;    // 第一个阻尼系数被拒绝后，其余的一次批量计算 (需要 batchResiduals)
+        bool geodesicAcceleration = false;  // 测地加速修正 (每轮多计算一次残差)
+        double geodesicRatio = 0.75;    // 加速项与速度项之比 2|a|/|v| 超过此值时放弃修正
+    };
+
+    enum StopReason {
+        Converged,          // 均方残差达到目标
+        MaxIterations,      // 达到最大迭代次数
+        DampingLimit,       // 阻尼系数过大，无法继续下降
+        Cancelled,          // 残差或雅可比回调返回 false
+        Stopped,            // continueIteration 回调返回 false (如多起点拟合中被剪枝)
+        InvalidInput        // 参数或残差为空
+    };
+
+    struct Statistics {
+        int iterations = 0;
+        int residualCount = 0;          // 残差向量长度
+        int residualEvaluations = 0;    // 残差回调次数 (含初始点)
+        int jacobianEvaluations = 0;    // 雅可比回调次数
+        int broydenUpdates = 0;
+        int rejectedSteps = 0;
+        int speculativeRounds = 0;      // 投机阻尼的批量计算轮数
+        int geodesicSteps = 0;          // 采用测地加速修正的步数
+        double initialSse = 0.0;
+        double finalSse = 0.0;
+        double finalLambda = 0.0;
+        StopReason stopReason = InvalidInput;
+    };
+
+    struct Problem {
+        ResidualFunction residuals;
+        JacobianFunction jacobian;
+        BatchResidualFunction batchResiduals;   // 可选，投机阻尼模式使用
+        Vector lower;                   // 迭代变量下界 (可为 -inf)
+        Vector upper;                   // 迭代变量上界 (可为 +inf)
+        std::function<void(int iteration, double sse)> iterationStarted;    // 可选，sse 为本轮起点的残差平方和
+        // 可选；x 是本轮残差最小的试探点，但不一定是最近一次残差回调的点 (测地加速的修正试探点在其后计算)
+        std::function<void(const Vector& x, double sse)> stepAccepted;
+        std::function<bool(int iteration, double sse)> continueIteration;  // 可选，每轮开始前调用，返回 false 时停止
+    };
+
+    LMOptimizer() = default;
+    explicit LMOptimizer(const Options& options) : m_options(options) {}
+
+    void setOptions(const Options& options) { m_options = options; }
+    const Options& options() const { return m_options; }
+
+    // 从 x 出发迭代，结束时 x 为当前最优点 (被取消时为取消前已接受的点)；返回停止原因
+    StopReason minimize(const Problem& problem, Vector& x);
+
+    const Statistics& statistics() const { return m_stats; }
+    // 当前最优点的残差 (minimize 返回后有效)
+    const Vector& residuals() const { return m_r; }
+
+private:
+    // 缩放雅可比矩阵并做奇异值分解，供本轮各次阻尼试探复用
+    void factorize();
+    // 由分解结果求阻尼系数为 lambda 时 (J^T J + lambda * D) delta = -J^T r 的解，utr = U^T r
+    void solveDamped(double lambda, const Vector& utr, Vector& delta);
+    // 记下本轮第一个试探点 (m_step、m_rTrial) 作为测地加速的基础：r_vv ≈ 2 (r(x + v) - r - J v)
+    void rememberGeodesicBase();
+    // J += (rTrial - r - J * step) * step^T / (step^T * step)
+    bool broydenUpdate();
+
+    Options m_options;
+    Statistics m_stats;
+
+    // 工作区 (尺寸不变时跨轮、跨次调用复用)
+    Matrix m_J;
+    Matrix m_scaledJ;
+    Vector m_r;
+    Vector m_rTrial;
+    Vector m_xTrial;
+    Vector m_step;
+    Vector m_delta;
+    Vector m_columnScale;   // D^(-1/2)
+    Vector m_utr;           // U^T r
+    Vector m_z;             // V^T D^(1/2) delta
+    Vector m_predicted;
+    Matrix m_X;             // 投机阻尼的各试探点 (按列)
+    Matrix m_R;             // 对应残差
+    Vector m_xStart;        // 本轮起点
+    Vector m_velocity;      // 测地加速：第一个试探点的步长 v
+    Vector m_rvv;           // 残差的方向二阶导数估计
+    Vector m_utrvv;         // U^T r_vv
+    Vector m_acceleration;
+    Eigen::JacobiSVD<Matrix> m_svd;
+};
+
+#endif // LMOPTIMIZER_H
@@ -143,6 +143,15 @@ void ModelManager::setHighPrecision(bool high) {
     }
 }
 
+void ModelManager::setSolverSettings(const SolverSettings& settings) {
+    for(WT_ModelWidget* w : m_modelWidgets) {
+        w->setSolverSettings(settings);
+    }
+    for(ModelSolver01_06* s : m_solvers) {
+        s->setSolverSettings(settings);
+    }
+}
+
 void ModelManager::updateAllModelsBasicParameters()
 {
     for(WT_ModelWidget* w : m_modelWidgets) {
@@ -201,11 +210,105 @@ ModelCurveData ModelManager::calculateTheoreticalCurve(ModelType type, const QMa
     return ModelCurveData();
 }
 
+ModelCurveData ModelManager::calculateTheoreticalCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime, const SolverSettings& settings)
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_solvers.size()) {
+        return m_solvers[index]->calculateTheoreticalCurve(params, providedTime, settings);
+    }
+    return ModelCurveData();
+}
+
+ModelCurveData ModelManager::calculateTheoreticalCurve(ModelType type, const ModelParams& params, const QVector<double>& providedTime)
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_solvers.size()) {
+        return m_solvers[index]->calculateTheoreticalCurve(params, providedTime);
+    }
+    return ModelCurveData();
+}
+
+ModelCurveData ModelManager::calculateTheoreticalCurve(ModelType type, const ModelParams& params, const QVector<double>& providedTime, const SolverSettings& settings)
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_solvers.size()) {
+        return m_solvers[index]->calculateTheoreticalCurve(params, providedTime, settings);
+    }
+    return ModelCurveData();
+}
+
+ModelCurveData ModelManager::calculateTheoreticalCurve(ModelType type, const ModelParams& params, const QVector<double>& providedTime, const SolverContext& context)
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_solvers.size()) {
+        return m_solvers[index]->calculateTheoreticalCurve(params, providedTime, context);
+    }
+    return ModelCurveData();
+}
+
+QVector<ModelCurveData> ModelManager::calculateTheoreticalCurves(ModelType type, const QVector<ModelParams>& paramsList, const QVector<double>& providedTime)
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_solvers.size()) {
+        return m_solvers[index]->calculateTheoreticalCurves(paramsList, providedTime);
+    }
+    return QVector<ModelCurveData>(paramsList.size());
+}
+
+QVector<ModelCurveData> ModelManager::calculateTheoreticalCurves(ModelType type, const QVector<ModelParams>& paramsList, const QVector<double>& providedTime, const SolverContext& context)
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_solvers.size()) {
+        return m_solvers[index]->calculateTheoreticalCurves(paramsList, providedTime, context);
+    }
+    return QVector<ModelCurveData>(paramsList.size());
+}
+
+ModelCurveSensitivity ModelManager::calculateSensitivities(ModelType type, const ModelParams& params, const QVector<ModelParams::Index>& which,
+                                                           const QVector<double>& providedTime, const SolverContext& context)
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_solvers.size()) {
+        return m_solvers[index]->calculateSensitivities(params, which, providedTime, context);
+    }
+    return ModelCurveSensitivity();
+}
+
+SolverSettings ModelManager::solverSettings(ModelType type) const
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_solvers.size()) {
+        return m_solvers[index]->solverSettings();
+    }
+    return SolverSettings();
+}
+
+SolverSettings ModelManager::previewSettings(ModelType type) const
+{
+    SolverSettings settings = solverSettings(type);
+    settings.useCurveCache = true;
+    settings.interpolateLaplace = true;
+    return settings;
+}
+
+ModelCurveData ModelManager::calculatePreviewCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime)
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_solvers.size()) {
+        return m_solvers[index]->calculateTheoreticalCurve(params, providedTime, previewSettings(type));
+    }
+    return ModelCurveData();
+}
+
 QVector<double> ModelManager::generateLogTimeSteps(int count, double startExp, double endExp) {
     // 委托给 Solver 的静态方法
     return ModelSolver01_06::generateLogTimeSteps(count, startExp, endExp);
 }
 
+void ModelManager::setThreadCount(int count) {
+    ModelSolver01_06::setThreadCount(count);
+}
+
 void ModelManager::setObservedData(const QVector<double>& t, const QVector<double>& p, const QVector<double>& d)
 {
     m_cachedObsTime = t;
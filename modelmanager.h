@@ -49,18 +49,52 @@ public:
     // 核心计算接口：代理给对应的 Solver 进行计算 (线程安全，可在拟合线程调用)
     ModelCurveData calculateTheoreticalCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>());
 
+    // 使用指定求解配置 (反演方法/阶数) 计算，不改变求解器的默认配置
+    ModelCurveData calculateTheoreticalCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime, const SolverSettings& settings);
+
+    // 定长参数结构接口 (拟合等高频调用使用，避免 QMap 拷贝与字符串查找)
+    ModelCurveData calculateTheoreticalCurve(ModelType type, const ModelParams& params, const QVector<double>& providedTime = QVector<double>());
+    ModelCurveData calculateTheoreticalCurve(ModelType type, const ModelParams& params, const QVector<double>& providedTime, const SolverSettings& settings);
+
+    // 使用调用者的求解上下文 (精度、反演配置、临时缓冲区、取消标志与截止时间) 计算，不读写任何全局状态，可并发调用；
+    // 被取消或超时时返回空曲线
+    ModelCurveData calculateTheoreticalCurve(ModelType type, const ModelParams& params, const QVector<double>& providedTime, const SolverContext& context);
+
+    // 批量计算多组参数 (雅可比、敏感性分析)，共享时间序列并在多核上并行，结果顺序与输入一致
+    QVector<ModelCurveData> calculateTheoreticalCurves(ModelType type, const QVector<ModelParams>& paramsList, const QVector<double>& providedTime = QVector<double>());
+    QVector<ModelCurveData> calculateTheoreticalCurves(ModelType type, const QVector<ModelParams>& paramsList, const QVector<double>& providedTime, const SolverContext& context);
+
+    // 理论曲线及其对 which 中各参数的偏导 (一次求解得到，拟合的解析雅可比使用)；被取消时返回空结果
+    ModelCurveSensitivity calculateSensitivities(ModelType type, const ModelParams& params, const QVector<ModelParams::Index>& which,
+                                                 const QVector<double>& providedTime, const SolverContext& context);
+
+    // 获取指定模型求解器的默认求解配置 (供调用者构造求解上下文)
+    SolverSettings solverSettings(ModelType type) const;
+
+    // 交互预览使用的求解配置 (默认配置 + 无因次曲线缓存 + 射线插值)
+    SolverSettings previewSettings(ModelType type) const;
+
+    // 交互预览计算：在默认求解配置上启用无因次曲线缓存与射线插值 (滚轮调参、敏感性分析等)，结果为插值近似
+    ModelCurveData calculatePreviewCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>());
+
     // 获取默认参数
     QMap<QString, double> getDefaultParameters(ModelType type);
 
     // 设置全局计算精度
     void setHighPrecision(bool high);
 
+    // 设置全局默认求解配置 (反演方法与阶数)
+    void setSolverSettings(const SolverSettings& settings);
+
     // 刷新所有界面模型的参数显示
     void updateAllModelsBasicParameters();
 
     // 生成对数时间步长 (静态工具)
     static QVector<double> generateLogTimeSteps(int count, double startExp, double endExp);
 
+    // 设置求解器并行线程数 (静态工具，1 表示串行)
+    static void setThreadCount(int count);
+
     // 观测数据缓存管理
     void setObservedData(const QVector<double>& t, const QVector<double>& p, const QVector<double>& d);
     void getObservedData(QVector<double>& t, QVector<double>& p, QVector<double>& d) const;
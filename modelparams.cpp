@@ -0,0 +1,63 @@
+/*
+ * modelparams.cpp
+ * 文件作用: 求解器参数定长结构实现
+ * 功能描述:
+ * 1. 参数名称表与枚举下标一一对应。
+ * 2. 实现 QMap 与定长结构之间的转换，以及 LfD 联动逻辑。
+ */
+
+#include "modelparams.h"
+
+namespace {
+// 与 ModelParams::Index 顺序一致
+const char* const kParamNames[ModelParams::Count] = {
+    "phi", "h", "mu", "B", "Ct", "q", "nf", "kf", "km", "L", "Lf", "LfD",
+    "rmD", "reD", "omega1", "omega2", "lambda1", "gamaD", "cD", "S", "N"
+};
+}
+
+ModelParams::ModelParams()
+    : m_mask(0)
+{
+    m_values.fill(0.0);
+}
+
+void ModelParams::updateLfD()
+{
+    if (has(L) && has(Lf) && m_values[L] > 1e-9) {
+        set(LfD, m_values[Lf] / m_values[L]);
+    }
+}
+
+ModelParams ModelParams::fromMap(const QMap<QString, double>& map)
+{
+    ModelParams p;
+    for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+        int idx = indexOf(it.key());
+        if (idx >= 0) p.set((Index)idx, it.value());
+    }
+    return p;
+}
+
+QMap<QString, double> ModelParams::toMap() const
+{
+    QMap<QString, double> map;
+    for (int i = 0; i < Count; ++i) {
+        if (has((Index)i)) map.insert(kParamNames[i], m_values[i]);
+    }
+    return map;
+}
+
+int ModelParams::indexOf(const QString& name)
+{
+    for (int i = 0; i < Count; ++i) {
+        if (name == QLatin1String(kParamNames[i])) return i;
+    }
+    return -1;
+}
+
+QString ModelParams::nameOf(int index)
+{
+    if (index < 0 || index >= Count) return QString();
+    return QString::fromLatin1(kParamNames[index]);
+}
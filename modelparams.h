@@ -0,0 +1,75 @@
+/*
+ * modelparams.h
+ * 文件作用: 求解器参数定长结构头文件
+ * 功能描述:
+ * 1. 以编译期固定的枚举下标存放模型参数，替代求解热点路径中的 QMap<QString,double>。
+ * 2. 记录每个参数是否被设置，value(下标, 默认值) 的语义与 QMap::value(键, 默认值) 一致。
+ * 3. 提供与 QMap 互相转换的接口，QMap 仅在界面边界使用；未知键 (如 "C"、"t") 在转换时忽略。
+ * 4. 纯数据结构，可按值拷贝 (无堆分配)，适合拟合时的参数扰动。
+ */
+
+#ifndef MODELPARAMS_H
+#define MODELPARAMS_H
+
+#include <QMap>
+#include <QString>
+#include <array>
+
+class ModelParams
+{
+public:
+    // 参数下标 (名称见 nameOf，与界面/QMap 中的键一一对应)
+    enum Index {
+        Phi = 0,    // "phi"     孔隙度
+        H,          // "h"       有效厚度
+        Mu,         // "mu"      粘度
+        B,          // "B"       体积系数
+        Ct,         // "Ct"      综合压缩系数
+        Q,          // "q"       产量
+        Nf,         // "nf"      裂缝条数
+        Kf,         // "kf"      内区渗透率
+        Km,         // "km"      外区渗透率
+        L,          // "L"       水平井长度
+        Lf,         // "Lf"      裂缝半长
+        LfD,        // "LfD"     无因次缝长
+        RmD,        // "rmD"     无因次复合半径
+        ReD,        // "reD"     无因次边界半径
+        Omega1,     // "omega1"  储容比 1
+        Omega2,     // "omega2"  储容比 2
+        Lambda1,    // "lambda1" 窜流系数
+        GamaD,      // "gamaD"   压敏系数
+        CD,         // "cD"      无因次井储
+        S,          // "S"       表皮系数
+        N,          // "N"       Stehfest 反演阶数
+        Count
+    };
+
+    ModelParams();
+
+    // 参数是否已设置
+    bool has(Index i) const { return (m_mask >> i) & 1u; }
+
+    // 取值：未设置时返回默认值
+    double value(Index i, double defaultValue = 0.0) const { return has(i) ? m_values[i] : defaultValue; }
+
+    // 设置/移除参数
+    void set(Index i, double v) { m_values[i] = v; m_mask |= (1u << i); }
+    void remove(Index i) { m_values[i] = 0.0; m_mask &= ~(1u << i); }
+
+    // 按 L 与 Lf 同步无因次缝长 LfD = Lf / L (与界面逻辑一致)
+    void updateLfD();
+
+    // 与 QMap 之间的转换 (界面边界的适配器)
+    static ModelParams fromMap(const QMap<QString, double>& map);
+    QMap<QString, double> toMap() const;
+
+    // 名称与下标互查，未知名称返回 -1
+    static int indexOf(const QString& name);
+    static QString nameOf(int index);
+
+private:
+    std::array<double, Count> m_values;
+    unsigned int m_mask;    // 第 i 位表示参数 i 已设置
+};
+
+#endif // MODELPARAMS_H
@@ -3,28 +3,169 @@
  * 文件作用: 压裂水平井复合页岩油模型核心计算类实现
  * 功能描述:
  * 1. 实现6种不同边界和井储条件组合的页岩油数学模型解。
- * 2. 包含 Stehfest 数值反演算法、自适应高斯积分、Bessel 函数调用等核心算法。
+ * 2. 包含数值反演、自适应高斯积分、Bessel 函数调用等核心算法。
  * 3. 实现了数据处理和物理量到无因次量的转换逻辑。
  * 4. [修改] 强制在计算中执行 LfD = Lf / L 的约束逻辑，确保物理意义一致。
+ * 5. 利用等间距裂缝影响系数矩阵的对称 Toeplitz 结构，只计算 nf 个不同间距的积分，并用 Levinson 递推求解流量分布。
+ * 6. 拉普拉斯函数按标量类型模板化：Stehfest 走实数路径，Talbot/de Hoog 走复数路径，Bessel 函数均由 BesselFunctions 提供，
+ *    反演节点与权重由 LaplaceInversion 预计算共享。
+ * 7. 按 (时间点 × 反演节点) 展开任务在计算线程池中并行执行，各任务只写入自己的结果槽位，
+ *    反演求和按固定顺序完成，结果与线程数无关。
+ * 8. 热点路径按枚举下标读取 ModelParams，不再进行字符串查找。
+ * 9. 裂缝影响积分使用模板化 Gauss-Kronrod 积分器 (gausskronrod.h)，15 个节点的 Bessel 函数批量计算，
+ *    自身影响积分在对数奇点处分段。
+ * 10. 井储与表皮只是拉普拉斯解的后处理，缓存不含井储的函数值 (按几何参数、tD 序列、反演配置作键)，
+ *     拟合 cD、S 时只需重做后处理与反演。
+ * 11. 无因次曲线缓存：物理量只经 td_coeff、p_coeff 进入结果，形状由无因次参数决定。缓存在对数等距 tD 网格上的
+ *     pD 与导数 (网格向请求范围两侧各外扩 1 个对数周期)，命中后用双对数 PCHIP 插值到请求的 tD。
+ * 12. 可选解析导数：t*dpD/dt 的拉普拉斯变换为 s*F(s)，复用同一组拉普拉斯函数值反演，不依赖时间点疏密。
+ * 13. 可选射线插值：时间点较多时，沿各反演节点射线对 s*F(s) 做自适应 Chebyshev 插值 (laplaceinterpolator.h)，
+ *     用插值结果代替逐节点求解。
+ * 14. 求解器可重入：所有调用参数来自 SolverContext，默认配置只在调用入口加锁拷贝一次，缓存读写加锁，
+ *     临时缓冲区可由调用者通过 SolverWorkspace 复用。
+ * 15. 批量计算 (雅可比、敏感性分析)：各组未命中缓存的 (时间点 × 节点) 任务合并为一个列表并行求解，再按组并行反演，
+ *     组数少于或不整除线程数时也不会有线程空等，且不在线程池任务内部嵌套等待；结果按下标写入，与线程数无关。
+ * 16. 裂缝流量方程组按裂缝条数分派到编译期定长实现 (nf <= kMaxFixedFractures)：系数矩阵与 Levinson 递推的
+ *     中间向量均在栈上，稠密回退使用部分选主元 LU；裂缝更多时使用动态大小与全选主元 LU。
+ * 17. 协作取消：每个 (时间点, 节点) 任务开始前检查取消标志与截止时间，停止后跳过剩余任务，
+ *     返回空曲线，且不把不完整的结果写入缓存。
+ * 18. 参数灵敏度 (前向自动微分)：无因次参数与拉普拉斯变量 s 作为对偶数方向传入拉普拉斯函数，Bessel 函数、积分限 (Leibniz 公式)
+ *     与裂缝流量方程组 (A0 * dy = -dA * y0) 均按解析公式求导；井储表皮、反演、压敏修正与换算系数在对偶数之外按链式法则处理，
+ *     td_coeff 类参数 (kf、phi、mu、Ct、L) 经 s 方向的偏导处理节点随 tD 的移动。
  */
 
 #include "modelsolver01-06.h"
 #include "pressurederivativecalculator.h"
+#include "besselfunctions.h"
+#include "gausskronrod.h"
+#include "curveinterpolator.h"
+#include "laplaceinterpolator.h"
 
 #include <Eigen/Dense>
-#include <boost/math/special_functions/bessel.hpp>
 #include <cmath>
 #include <algorithm>
+#include <type_traits>
 #include <QDebug>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+#include <QMutexLocker>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+using Complex = std::complex<double>;
+
+namespace {
+inline bool isFiniteValue(double v) { return std::isfinite(v); }
+inline bool isFiniteValue(const Complex& v) { return std::isfinite(v.real()) && std::isfinite(v.imag()); }
+
+// 无因次曲线缓存网格：每个对数周期的点数、两侧外扩的对数周期数、合并已有范围时的最大跨度
+const int kCurvePointsPerDecade = 20;
+const double kCurveMarginDecades = 1.0;
+const double kCurveMaxDecades = 12.0;
+
+// 射线插值：启用所需的最少时间点数 (点数少时逐节点求解更省)，以及相对误差容限
+// (Stehfest 权重交错且量级大，插值误差被放大，需更严的容限)
+const int kRayInterpolationMinPoints = 64;
+const double kRayInterpolationTolStehfest = 1e-10;
+const double kRayInterpolationTolComplex = 1e-8;
+inline double rayInterpolationTolerance(const LaplaceInversion::Table& tab) { return tab.complexNodes ? kRayInterpolationTolComplex : kRayInterpolationTolStehfest; }
+
+// 使用编译期定长矩阵的最大裂缝条数 (每个取值为实数、复数各实例化一份)
+const int kMaxFixedFractures = 8;
+
+// 按裂缝条数分派：nf 为 1..N 时以 std::integral_constant<int, nf> 调用 f，否则以 Eigen::Dynamic 调用
+template<int N>
+struct FractureCountDispatch {
+    template<typename F>
+    static auto run(int nf, const F& f) {
+        return (nf == N) ? f(std::integral_constant<int, N>()) : FractureCountDispatch<N - 1>::run(nf, f);
+    }
+};
+
+template<>
+struct FractureCountDispatch<0> {
+    template<typename F>
+    static auto run(int, const F& f) { return f(std::integral_constant<int, Eigen::Dynamic>()); }
+};
+
+// 参数灵敏度中以对偶数传播的方向：拉普拉斯空间无因次参数，以及拉普拉斯变量 s (td_coeff 类参数需要 dF/ds)
+enum DualDirection { DirM12 = 0, DirLfD, DirRmD, DirReD, DirOmega1, DirOmega2, DirLambda1, DirS, kDualDirections };
+
+// 单个模型参数对各中间量的偏导
+struct ParameterChain {
+    double laplace[DirS] = {};  // d(M12, LfD, rmD, reD, omega1, omega2, lambda1) / dθ
+    double cD = 0.0;            // dcD / dθ
+    double S = 0.0;             // dS / dθ
+    double gamaD = 0.0;         // dgamaD / dθ
+    double lnTd = 0.0;          // dln(td_coeff) / dθ
+    double lnP = 0.0;           // dln(p_coeff) / dθ
+};
+
+// 与 dimensionlessCoefficients、makeLaplaceParams 的换算关系 (含默认值) 保持一致
+ParameterChain parameterChain(const ModelParams& p, ModelParams::Index index, ModelSolver01_06::ModelType type)
+{
+    ParameterChain c;
+    double L = p.value(ModelParams::L);
+    switch (index) {
+    case ModelParams::Phi: c.lnTd = -1.0 / p.value(ModelParams::Phi, 0.05); break;
+    case ModelParams::Mu:
+        c.lnTd = -1.0 / p.value(ModelParams::Mu, 0.5);
+        c.lnP = 1.0 / p.value(ModelParams::Mu, 0.5);
+        break;
+    case ModelParams::Ct: c.lnTd = -1.0 / p.value(ModelParams::Ct, 5e-4); break;
+    case ModelParams::B: c.lnP = 1.0 / p.value(ModelParams::B, 1.05); break;
+    case ModelParams::Q: c.lnP = 1.0 / p.value(ModelParams::Q, 5.0); break;
+    case ModelParams::H: c.lnP = -1.0 / p.value(ModelParams::H, 20.0); break;
+    case ModelParams::Kf:
+        c.lnTd = 1.0 / p.value(ModelParams::Kf, 1e-3);
+        c.lnP = -1.0 / p.value(ModelParams::Kf, 1e-3);
+        c.laplace[DirM12] = 1.0 / p.value(ModelParams::Km);
+        break;
+    case ModelParams::Km: {
+        double km = p.value(ModelParams::Km);
+        c.laplace[DirM12] = -p.value(ModelParams::Kf) / (km * km);
+        break;
+    }
+    case ModelParams::L:
+        c.lnTd = -2.0 / p.value(ModelParams::L, 1000.0);
+        if (L > 1e-9) c.laplace[DirLfD] = -p.value(ModelParams::Lf) / (L * L);
+        break;
+    case ModelParams::Lf:
+        if (L > 1e-9) c.laplace[DirLfD] = 1.0 / L;
+        break;
+    case ModelParams::LfD:
+        if (!(L > 1e-9)) c.laplace[DirLfD] = 1.0;
+        break;
+    case ModelParams::RmD: c.laplace[DirRmD] = 1.0; break;
+    case ModelParams::ReD:
+        // 无限大模型不含外边界
+        if (type != ModelSolver01_06::Model_1 && type != ModelSolver01_06::Model_2) c.laplace[DirReD] = 1.0;
+        break;
+    case ModelParams::Omega1: c.laplace[DirOmega1] = 1.0; break;
+    case ModelParams::Omega2: c.laplace[DirOmega2] = 1.0; break;
+    case ModelParams::Lambda1: c.laplace[DirLambda1] = 1.0; break;
+    case ModelParams::GamaD: c.gamaD = 1.0; break;
+    case ModelParams::CD:
+    case ModelParams::S:
+        // 仅变井储模型使用井储与表皮
+        if (type == ModelSolver01_06::Model_1 || type == ModelSolver01_06::Model_3 || type == ModelSolver01_06::Model_5) {
+            (index == ModelParams::CD ? c.cD : c.S) = 1.0;
+        }
+        break;
+    default:
+        // nf、N 为离散参数
+        break;
+    }
+    return c;
+}
+}
+
 // 构造函数
 ModelSolver01_06::ModelSolver01_06(ModelType type)
     : m_type(type)
-    , m_highPrecision(true)
 {
 }
 
@@ -36,7 +177,21 @@ ModelSolver01_06::~ModelSolver01_06()
 // 设置精度
 void ModelSolver01_06::setHighPrecision(bool high)
 {
-    m_highPrecision = high;
+    QMutexLocker locker(&m_settingsMutex);
+    m_settings.highPrecision = high;
+}
+
+// 设置默认求解配置
+void ModelSolver01_06::setSolverSettings(const SolverSettings& settings)
+{
+    QMutexLocker locker(&m_settingsMutex);
+    m_settings = settings;
+}
+
+SolverSettings ModelSolver01_06::solverSettings() const
+{
+    QMutexLocker locker(&m_settingsMutex);
+    return m_settings;
 }
 
 // 获取模型名称
@@ -66,8 +221,68 @@ QVector<double> ModelSolver01_06::generateLogTimeSteps(int count, double startEx
     return t;
 }
 
+// 清空缓存
+void ModelSolver01_06::clearLaplaceCache()
+{
+    QMutexLocker locker(&m_cacheMutex);
+    m_laplaceCache.clear();
+}
+
+void ModelSolver01_06::clearCurveCache()
+{
+    QMutexLocker locker(&m_cacheMutex);
+    m_curveCache.clear();
+}
+
+// 计算线程池 (首次使用时创建，默认线程数为 CPU 核心数)
+QThreadPool* ModelSolver01_06::computePool()
+{
+    static QThreadPool pool;
+    return &pool;
+}
+
+void ModelSolver01_06::setThreadCount(int count)
+{
+    if (count <= 0) count = QThread::idealThreadCount();
+    computePool()->setMaxThreadCount(count);
+}
+
+int ModelSolver01_06::threadCount()
+{
+    return computePool()->maxThreadCount();
+}
+
+// 取消检查 (在计算任务中频繁调用，只做一次原子读与时钟比较)
+bool ModelSolver01_06::isCancelled(const SolverContext& context)
+{
+    if (context.cancel && context.cancel->load(std::memory_order_relaxed)) return true;
+    return context.deadline.hasExpired();
+}
+
 // 核心计算函数
 ModelCurveData ModelSolver01_06::calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime)
+{
+    return calculateTheoreticalCurve(ModelParams::fromMap(params), providedTime, solverSettings());
+}
+
+ModelCurveData ModelSolver01_06::calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime, const SolverSettings& settings)
+{
+    return calculateTheoreticalCurve(ModelParams::fromMap(params), providedTime, settings);
+}
+
+ModelCurveData ModelSolver01_06::calculateTheoreticalCurve(const ModelParams& params, const QVector<double>& providedTime)
+{
+    return calculateTheoreticalCurve(params, providedTime, solverSettings());
+}
+
+ModelCurveData ModelSolver01_06::calculateTheoreticalCurve(const ModelParams& params, const QVector<double>& providedTime, const SolverSettings& settings)
+{
+    SolverContext context;
+    context.settings = settings;
+    return calculateTheoreticalCurve(params, providedTime, context);
+}
+
+ModelCurveData ModelSolver01_06::calculateTheoreticalCurve(const ModelParams& params, const QVector<double>& providedTime, const SolverContext& context)
 {
     // 1. 准备时间序列
     QVector<double> tPoints = providedTime;
@@ -75,166 +290,849 @@ ModelCurveData ModelSolver01_06::calculateTheoreticalCurve(const QMap<QString, d
         tPoints = generateLogTimeSteps(100, -3.0, 3.0);
     }
 
-    // 2. 提取物理参数
-    double phi = params.value("phi", 0.05);
-    double mu = params.value("mu", 0.5);
-    double B = params.value("B", 1.05);
-    double Ct = params.value("Ct", 5e-4);
-    double q = params.value("q", 5.0);
-    double h = params.value("h", 20.0);
-    double kf = params.value("kf", 1e-3);
-    double L = params.value("L", 1000.0);
+    // 2. 计算无因次时间 tD
+    double td_coeff, p_coeff;
+    dimensionlessCoefficients(params, td_coeff, p_coeff);
 
-    // 3. 计算无因次时间 tD
-    // 注意：这里的系数 14.4 是基于特定单位制的工程常数
-    // 公式: tD = C * k * t / (phi * mu * Ct * L^2)
-    double td_coeff = 14.4 * kf / (phi * mu * Ct * pow(L, 2));
-
-    QVector<double> tD_vec;
-    tD_vec.reserve(tPoints.size());
-    for(double t : tPoints) {
-        double val = td_coeff * t;
-        tD_vec.append(val);
+    SolverWorkspace localWorkspace;
+    QVector<double>& tD_vec = context.workspace ? context.workspace->tD : localWorkspace.tD;
+    tD_vec.resize(tPoints.size());
+    for(int i = 0; i < tPoints.size(); ++i) {
+        tD_vec[i] = td_coeff * tPoints[i];
     }
 
-    // 4. 计算无因次压力和导数
+    // 3. 计算无因次压力和导数
     QVector<double> PD_vec, Deriv_vec;
-    auto func = std::bind(&ModelSolver01_06::flaplace_composite, this, std::placeholders::_1, std::placeholders::_2);
-    calculatePDandDeriv(tD_vec, params, func, PD_vec, Deriv_vec);
+    bool completed = context.settings.useCurveCache
+            ? calculatePDandDerivCached(tD_vec, params, context, PD_vec, Deriv_vec)
+            : calculatePDandDeriv(tD_vec, params, context, PD_vec, Deriv_vec);
+    if (!completed) return ModelCurveData();
+
+    // 4. 将无因次量转换为物理量 (压差 dp)
+    return toPhysicalCurve(tPoints, PD_vec, Deriv_vec, p_coeff);
+}
+
+// 无因次换算系数 (tD = td_coeff * t，dp = p_coeff * pD)
+void ModelSolver01_06::dimensionlessCoefficients(const ModelParams& params, double& tdCoeff, double& pCoeff)
+{
+    double phi = params.value(ModelParams::Phi, 0.05);
+    double mu = params.value(ModelParams::Mu, 0.5);
+    double B = params.value(ModelParams::B, 1.05);
+    double Ct = params.value(ModelParams::Ct, 5e-4);
+    double q = params.value(ModelParams::Q, 5.0);
+    double h = params.value(ModelParams::H, 20.0);
+    double kf = params.value(ModelParams::Kf, 1e-3);
+    double L = params.value(ModelParams::L, 1000.0);
+
+    // 注意：这里的系数 14.4 是基于特定单位制的工程常数
+    // 公式: tD = C * k * t / (phi * mu * Ct * L^2)
+    tdCoeff = 14.4 * kf / (phi * mu * Ct * pow(L, 2));
 
-    // 5. 将无因次量转换为物理量 (压差 dp)
     // dp = 1.842e-3 * q * mu * B / (k * h) * pD
-    double p_coeff = 1.842e-3 * q * mu * B / (kf * h);
+    pCoeff = 1.842e-3 * q * mu * B / (kf * h);
+}
 
+ModelCurveData ModelSolver01_06::toPhysicalCurve(const QVector<double>& tPoints, const QVector<double>& PD,
+                                                 const QVector<double>& deriv, double pCoeff)
+{
     QVector<double> finalP(tPoints.size()), finalDP(tPoints.size());
 
     for(int i=0; i<tPoints.size(); ++i) {
-        finalP[i] = p_coeff * PD_vec[i];
-        finalDP[i] = p_coeff * Deriv_vec[i];
+        finalP[i] = pCoeff * PD[i];
+        finalDP[i] = pCoeff * deriv[i];
     }
 
     return std::make_tuple(tPoints, finalP, finalDP);
 }
 
-// Stehfest 数值反演计算 PD 和导数
-void ModelSolver01_06::calculatePDandDeriv(const QVector<double>& tD, const QMap<QString, double>& params,
-                                           std::function<double(double, const QMap<QString, double>&)> laplaceFunc,
+// 批量计算
+QVector<ModelCurveData> ModelSolver01_06::calculateTheoreticalCurves(const QVector<ModelParams>& paramsList, const QVector<double>& providedTime)
+{
+    SolverContext context;
+    context.settings = solverSettings();
+    return calculateTheoreticalCurves(paramsList, providedTime, context);
+}
+
+QVector<ModelCurveData> ModelSolver01_06::calculateTheoreticalCurves(const QVector<ModelParams>& paramsList, const QVector<double>& providedTime, const SolverContext& context)
+{
+    int count = paramsList.size();
+    QVector<ModelCurveData> results(count);
+    if (count == 0) return results;
+
+    // 时间序列只准备一次，各组共享
+    QVector<double> tPoints = providedTime;
+    if (tPoints.isEmpty()) {
+        tPoints = generateLogTimeSteps(100, -3.0, 3.0);
+    }
+
+    // 曲线缓存与射线插值按组各自调度 (组内并行)；串行上下文逐组计算
+    const SolverSettings& settings = context.settings;
+    if (count == 1 || !context.parallel || threadCount() <= 1 || settings.useCurveCache || settings.interpolateLaplace) {
+        for (int i = 0; i < count; ++i) {
+            if (isCancelled(context)) break;
+            results[i] = calculateTheoreticalCurve(paramsList[i], tPoints, context);
+        }
+        return results;
+    }
+
+    // 1. 各组准备 tD、拉普拉斯参数并查找缓存
+    struct Member {
+        QVector<double> tD;
+        double pCoeff = 0.0;
+        const LaplaceInversion::Table* tab = nullptr;
+        LaplaceParams lp;
+        QVector<double> cacheKey;
+        QVector<Complex> raw;
+        Complex* rawOut = nullptr;
+        int firstTask = 0;      // 在合并任务列表中的起始下标 (命中缓存的组不占任务)
+        int sharedWith = -1;    // 与之前某组几何相同 (如只改变 cD、S) 时直接复用其结果
+    };
+    QVector<Member> members(count);
+    QVector<int> taskOffsets;   // 各待求解组的起始下标，末尾为任务总数
+    QVector<int> pendingMembers;
+    int totalTasks = 0;
+    for (int i = 0; i < count; ++i) {
+        Member& mb = members[i];
+        double tdCoeff;
+        dimensionlessCoefficients(paramsList[i], tdCoeff, mb.pCoeff);
+        mb.tD.resize(tPoints.size());
+        for (int k = 0; k < tPoints.size(); ++k) mb.tD[k] = tdCoeff * tPoints[k];
+
+        mb.tab = &LaplaceInversion::table(settings.inversion, inversionOrder(settings, paramsList[i]));
+        mb.lp = makeLaplaceParams(paramsList[i]);
+        mb.cacheKey = laplaceCacheKey(mb.lp, *mb.tab, mb.tD, false);
+        if (lookupLaplaceCache(mb.cacheKey, mb.raw)) continue;
+        for (int p : pendingMembers) {
+            if (members[p].cacheKey == mb.cacheKey) { mb.sharedWith = p; break; }
+        }
+        if (mb.sharedWith >= 0) continue;
+
+        int numTasks = mb.tD.size() * mb.tab->nodes.size();
+        mb.raw = QVector<Complex>(numTasks, Complex(0.0, 0.0));
+        mb.rawOut = mb.raw.data();
+        mb.firstTask = totalTasks;
+        taskOffsets.append(totalTasks);
+        pendingMembers.append(i);
+        totalTasks += numTasks;
+    }
+    taskOffsets.append(totalTasks);
+
+    // 2. 所有组的 (时间点 × 节点) 任务合并为一个列表并行求解，负载均衡与组数、线程数无关
+    const Member* memberData = members.constData();
+    if (totalTasks > 0) {
+        QVector<int> tasks(totalTasks);
+        for (int i = 0; i < totalTasks; ++i) tasks[i] = i;
+        QtConcurrent::blockingMap(computePool(), tasks, [&](int& task) {
+            if (isCancelled(context)) return;
+            int p = int(std::upper_bound(taskOffsets.constBegin(), taskOffsets.constEnd(), task) - taskOffsets.constBegin()) - 1;
+            const Member& mb = memberData[pendingMembers[p]];
+            int local = task - mb.firstTask;
+            int nNodes = mb.tab->nodes.size();
+            double t = mb.tD[local / nNodes];
+            if (t <= 1e-12) return;
+            mb.rawOut[local] = laplaceAtNode(*mb.tab, local % nNodes, t, mb.lp);
+        });
+        if (isCancelled(context)) return results;
+        for (int p : pendingMembers) storeLaplaceCache(members[p].cacheKey, members[p].raw);
+    }
+    for (Member& mb : members) {
+        if (mb.sharedWith >= 0) mb.raw = members[mb.sharedWith].raw;
+    }
+
+    // 3. 各组叠加井储表皮、反演并换算为物理量 (按组并行，各组独立缓冲区)
+    QVector<int> indices(count);
+    for (int i = 0; i < count; ++i) indices[i] = i;
+    ModelCurveData* out = results.data();
+    QtConcurrent::blockingMap(computePool(), indices, [&](int& i) {
+        const Member& mb = memberData[i];
+        SolverWorkspace workspace;
+        QVector<double> PD_vec, Deriv_vec;
+        invertLaplaceValues(mb.tD, paramsList[i], *mb.tab, mb.lp, mb.raw, settings, workspace, PD_vec, Deriv_vec);
+        out[i] = toPhysicalCurve(tPoints, PD_vec, Deriv_vec, mb.pCoeff);
+    });
+    return results;
+}
+
+// 确定反演阶数：显式指定优先；Stehfest 沿用原有规则 (高精度取参数 "N"，否则 4)
+int ModelSolver01_06::inversionOrder(const SolverSettings& settings, const ModelParams& params) const
+{
+    if (settings.order > 0) return settings.order;
+    if (settings.inversion == LaplaceInversion::Stehfest) {
+        int N_param = (int)params.value(ModelParams::N, 4);
+        return settings.highPrecision ? N_param : 4;
+    }
+    return LaplaceInversion::defaultOrder(settings.inversion, settings.highPrecision);
+}
+
+// 单个反演节点 s = alpha_m / t 处不含井储的拉普拉斯函数值 (Stehfest 节点为实数，走实数路径)
+Complex ModelSolver01_06::laplaceAtNode(const LaplaceInversion::Table& tab, int m, double t, const LaplaceParams& lp)
+{
+    if (tab.complexNodes) {
+        return flaplace_composite<Complex>(tab.nodes[m] / t, lp);
+    }
+    return flaplace_composite<double>(tab.nodes[m].real() / t, lp);
+}
+
+// 数值反演计算 PD 和导数
+bool ModelSolver01_06::calculatePDandDeriv(const QVector<double>& tD, const ModelParams& params,
+                                           const SolverContext& context,
                                            QVector<double>& outPD, QVector<double>& outDeriv)
+{
+    const SolverSettings& settings = context.settings;
+    SolverWorkspace localWorkspace;
+    SolverWorkspace& ws = context.workspace ? *context.workspace : localWorkspace;
+
+    int numPoints = tD.size();
+
+    // 节点/权重表只计算一次，所有时间点共享
+    const LaplaceInversion::Table& tab = LaplaceInversion::table(settings.inversion, inversionOrder(settings, params));
+    int nNodes = tab.nodes.size();
+    LaplaceParams lp = makeLaplaceParams(params);
+
+    // 1. 不含井储的拉普拉斯函数值，结果按 k * nNodes + m 存放；几何与时间序列不变时直接取缓存
+    int numTasks = numPoints * nNodes;
+    bool interpolate = settings.interpolateLaplace && numPoints >= kRayInterpolationMinPoints;
+    QVector<double> cacheKey = laplaceCacheKey(lp, tab, tD, interpolate);
+    QVector<Complex>& raw = ws.raw;
+    if (lookupLaplaceCache(cacheKey, raw)) {
+        // 命中缓存
+    } else if (interpolate) {
+        raw.resize(numTasks);
+        raw.fill(Complex(0.0, 0.0));
+        evaluateLaplaceInterpolated(tD, tab, lp, context, raw);
+        if (isCancelled(context)) return false;
+        storeLaplaceCache(cacheKey, raw);
+    } else {
+        raw.resize(numTasks);
+        raw.fill(Complex(0.0, 0.0));
+        Complex* rawOut = raw.data();
+
+        auto evaluate = [&](int task) {
+            double t = tD[task / nNodes];
+            if (t <= 1e-12 || isCancelled(context)) return;
+            rawOut[task] = laplaceAtNode(tab, task % nNodes, t, lp);
+        };
+
+        if (context.parallel && threadCount() > 1 && numTasks > 1) {
+            QVector<int> tasks(numTasks);
+            for (int i = 0; i < numTasks; ++i) tasks[i] = i;
+            QtConcurrent::blockingMap(computePool(), tasks, [&](int& task) { evaluate(task); });
+        } else {
+            for (int i = 0; i < numTasks; ++i) evaluate(i);
+        }
+        // 取消状态一经出现不会撤销，此处检查即可确定是否有任务被跳过
+        if (isCancelled(context)) return false;
+        storeLaplaceCache(cacheKey, raw);
+    }
+
+    invertLaplaceValues(tD, params, tab, lp, raw, settings, ws, outPD, outDeriv);
+    return true;
+}
+
+// 由不含井储的拉普拉斯函数值叠加井储表皮、逐点反演并计算导数 (ws.values / ws.scaled 作临时缓冲区)
+void ModelSolver01_06::invertLaplaceValues(const QVector<double>& tD, const ModelParams& params,
+                                           const LaplaceInversion::Table& tab, const LaplaceParams& lp,
+                                           const QVector<Complex>& raw, const SolverSettings& settings,
+                                           SolverWorkspace& ws, QVector<double>& outPD, QVector<double>& outDeriv) const
 {
     int numPoints = tD.size();
+    int nNodes = tab.nodes.size();
+    int numTasks = numPoints * nNodes;
     outPD.resize(numPoints);
     outDeriv.resize(numPoints);
 
-    int N_param = (int)params.value("N", 4);
-    int N = m_highPrecision ? N_param : 4;
-    if (N % 2 != 0) N = 4;
-    double ln2 = log(2.0);
+    // 1. 叠加井储和表皮 (开销可忽略)
+    ws.values.resize(numTasks);
+    ws.values.fill(Complex(0.0, 0.0));
+    Complex* out = ws.values.data();
+    for (int task = 0; task < numTasks; ++task) {
+        double t = tD[task / nNodes];
+        if (t <= 1e-12) continue;
+        if (tab.complexNodes) {
+            Complex pf = applyStorageSkin<Complex>(tab.nodes[task % nNodes] / t, raw[task], lp);
+            if (!isFiniteValue(pf)) pf = 0.0;
+            out[task] = pf;
+        } else {
+            double pf = applyStorageSkin<double>(tab.nodes[task % nNodes].real() / t, raw[task].real(), lp);
+            if (!isFiniteValue(pf)) pf = 0.0;
+            out[task] = pf;
+        }
+    }
 
-    double gamaD = params.value("gamaD", 0.0);
+    // 2. 逐点反演 (顺序固定，保证结果可复现)
+    double gamaD = params.value(ModelParams::GamaD, 0.0);
+    bool analytic = settings.analyticDerivative;
+    QVector<Complex>& scaled = ws.scaled;
+    if (analytic) scaled.resize(nNodes);
 
     for (int k = 0; k < numPoints; ++k) {
         double t = tD[k];
-        if (t <= 1e-12) { outPD[k] = 0; continue; }
+        if (t <= 1e-12) { outPD[k] = 0; outDeriv[k] = 0; continue; }
+
+        const Complex* pointValues = out + (size_t)k * nNodes;
+        outPD[k] = LaplaceInversion::invert(tab, t, pointValues);
 
-        double pd_val = 0.0;
-        for (int m = 1; m <= N; ++m) {
-            double z = m * ln2 / t;
-            double pf = laplaceFunc(z, params);
-            if (std::isnan(pf) || std::isinf(pf)) pf = 0.0;
-            pd_val += stefestCoefficient(m, N) * pf;
+        // 解析导数: L[t * dp/dt] 在节点 s = alpha/t 处的反演等价于对 alpha * F(s) 反演 (pD(0) = 0)
+        if (analytic) {
+            for (int m = 0; m < nNodes; ++m) scaled[m] = tab.nodes[m] * pointValues[m];
+            outDeriv[k] = LaplaceInversion::invert(tab, t, scaled.constData());
         }
-        outPD[k] = pd_val * ln2 / t;
 
-        // 考虑压敏效应修正
+        // 考虑压敏效应修正 (解析导数按链式法则: d/dlnt [-ln(1 - gamaD*pD)/gamaD] = dpD/dlnt / (1 - gamaD*pD))
         if (std::abs(gamaD) > 1e-9) {
             double arg = 1.0 - gamaD * outPD[k];
             if (arg > 1e-12) {
                 outPD[k] = -1.0 / gamaD * std::log(arg);
+                if (analytic) outDeriv[k] /= arg;
             }
         }
     }
 
     // 计算导数 (Bourdet 导数)
-    if (numPoints > 2) {
+    if (analytic) {
+        // 已在反演时得到
+    } else if (numPoints > 2) {
         outDeriv = PressureDerivativeCalculator::calculateBourdetDerivative(tD, outPD, 0.1);
     } else {
         outDeriv.fill(0.0);
     }
 }
 
-// 拉普拉斯空间下的复合模型总函数 (包含井储和表皮)
-double ModelSolver01_06::flaplace_composite(double z, const QMap<QString, double>& p) {
-    double kf = p.value("kf");
-    double km = p.value("km");
+// 沿反演节点射线插值 s*F(s)，得到各 (时间点, 节点) 处不含井储的函数值
+void ModelSolver01_06::evaluateLaplaceInterpolated(const QVector<double>& tD, const LaplaceInversion::Table& tab,
+                                                   const LaplaceParams& lp, const SolverContext& context,
+                                                   QVector<Complex>& raw)
+{
+    int numPoints = tD.size();
+    int nNodes = tab.nodes.size();
+
+    // 1. 按方向 arg(alpha) 归并射线 (Stehfest 只有正实轴一条)，收集各射线上的目标 u = ln|s|
+    QVector<Complex> directions;
+    QVector<QVector<double>> targets;
+    QVector<int> rayOf(nNodes);
+    for (int m = 0; m < nNodes; ++m) {
+        Complex dir = tab.nodes[m] / std::abs(tab.nodes[m]);
+        int ray = -1;
+        for (int i = 0; i < directions.size(); ++i) {
+            if (directions[i] == dir) { ray = i; break; }
+        }
+        if (ray < 0) {
+            ray = directions.size();
+            directions.append(dir);
+            targets.append(QVector<double>());
+        }
+        rayOf[m] = ray;
+
+        double logR = std::log(std::abs(tab.nodes[m]));
+        for (double t : tD) {
+            if (t > 1e-12) targets[ray].append(logR - std::log(t));
+        }
+    }
+    for (QVector<double>& u : targets) std::sort(u.begin(), u.end());
+
+    // 2. 构建插值 (每层细化的节点在计算线程池中并行求解)
+    auto laplaceAt = [&](const Complex& s) -> Complex {
+        if (!tab.complexNodes) return flaplace_composite<double>(s.real(), lp);
+        return flaplace_composite<Complex>(s, lp);
+    };
+    auto forEach = [&](int count, const std::function<void(int)>& body) {
+        if (context.parallel && threadCount() > 1 && count > 1) {
+            QVector<int> idx(count);
+            for (int i = 0; i < count; ++i) idx[i] = i;
+            QtConcurrent::blockingMap(computePool(), idx, [&](int& i) { body(i); });
+        } else {
+            for (int i = 0; i < count; ++i) body(i);
+        }
+    };
+    // 取消后跳过剩余节点 (保持为 0)，结果由调用者丢弃
+    auto evaluate = [&](const QVector<Complex>& s, QVector<Complex>& values) {
+        forEach(s.size(), [&](int i) {
+            if (!isCancelled(context)) values[i] = s[i] * laplaceAt(s[i]);
+        });
+    };
+    LaplaceRayInterpolator interpolator;
+    interpolator.build(directions, targets, evaluate, rayInterpolationTolerance(tab));
+
+    // 3. 取各节点处的插值并除以 s；未插值的分段逐点求解
+    QVector<int> directTasks;
+    for (int k = 0; k < numPoints; ++k) {
+        double t = tD[k];
+        if (t <= 1e-12) continue;
+        for (int m = 0; m < nNodes; ++m) {
+            int task = k * nNodes + m;
+            Complex g;
+            if (!interpolator.value(rayOf[m], std::log(std::abs(tab.nodes[m])) - std::log(t), g)) {
+                directTasks.append(task);
+                continue;
+            }
+            Complex s = tab.nodes[m] / t;
+            raw[task] = tab.complexNodes ? g / s : Complex(g.real() / s.real(), 0.0);
+        }
+    }
+    forEach(directTasks.size(), [&](int i) {
+        if (isCancelled(context)) return;
+        int task = directTasks[i];
+        raw[task] = laplaceAt(tab.nodes[task % nNodes] / tD[task / nNodes]);
+    });
+}
+
+// 经无因次曲线缓存计算 PD 和导数
+bool ModelSolver01_06::calculatePDandDerivCached(const QVector<double>& tD, const ModelParams& params,
+                                                 const SolverContext& context,
+                                                 QVector<double>& outPD, QVector<double>& outDeriv)
+{
+    const SolverSettings& settings = context.settings;
+    int numPoints = tD.size();
+    outPD = QVector<double>(numPoints, 0.0);
+    outDeriv = QVector<double>(numPoints, 0.0);
+
+    // 1. 有效 tD 范围 (tD <= 1e-12 的点与直接计算一致，取 0)
+    QVector<int> validIndex;
+    QVector<double> validTD;
+    validIndex.reserve(numPoints);
+    validTD.reserve(numPoints);
+    for (int i = 0; i < numPoints; ++i) {
+        if (tD[i] > 1e-12) {
+            validIndex.append(i);
+            validTD.append(tD[i]);
+        }
+    }
+    if (validTD.isEmpty()) return true;
+    double tMin = *std::min_element(validTD.constBegin(), validTD.constEnd());
+    double tMax = *std::max_element(validTD.constBegin(), validTD.constEnd());
+
+    const LaplaceInversion::Table& tab = LaplaceInversion::table(settings.inversion, inversionOrder(settings, params));
+    LaplaceParams lp = makeLaplaceParams(params);
+    QVector<double> key = curveCacheKey(lp, params.value(ModelParams::GamaD, 0.0), tab, settings.analyticDerivative,
+                                        settings.interpolateLaplace);
+
+    // 2. 查找覆盖请求范围的缓存曲线
+    double lo = std::log10(tMin) - kCurveMarginDecades;
+    double hi = std::log10(tMax) + kCurveMarginDecades;
+    CurveCacheEntry entry;
+    bool hit = false;
+    {
+        QMutexLocker locker(&m_cacheMutex);
+        for (int i = 0; i < m_curveCache.size(); ++i) {
+            const CurveCacheEntry& e = m_curveCache[i];
+            if (e.key != key) continue;
+            if (e.tD.first() <= tMin && e.tD.last() >= tMax) {
+                entry = e;
+                hit = true;
+                if (i > 0) m_curveCache.move(i, 0);
+            } else {
+                // 同一形状但范围不足：与已有范围合并，避免来回调整时反复求解
+                double mergedLo = qMin(lo, std::log10(e.tD.first()));
+                double mergedHi = qMax(hi, std::log10(e.tD.last()));
+                if (mergedHi - mergedLo <= kCurveMaxDecades) {
+                    lo = mergedLo;
+                    hi = mergedHi;
+                }
+            }
+            break;
+        }
+    }
+
+    // 3. 未命中：在对数等距网格上求解并写入缓存
+    if (!hit) {
+        int count = (int)std::ceil((hi - lo) * kCurvePointsPerDecade) + 1;
+        entry.key = key;
+        entry.tD = generateLogTimeSteps(count, lo, hi);
+        if (!calculatePDandDeriv(entry.tD, params, context, entry.pD, entry.deriv)) return false;
+
+        QMutexLocker locker(&m_cacheMutex);
+        for (int i = 0; i < m_curveCache.size(); ++i) {
+            if (m_curveCache[i].key == key) {
+                m_curveCache.removeAt(i);
+                break;
+            }
+        }
+        m_curveCache.prepend(entry);
+        while (m_curveCache.size() > kCurveCacheSize) m_curveCache.removeLast();
+    }
+
+    // 4. 双对数插值到请求的 tD
+    QVector<double> pD = CurveInterpolator::pchipLogLog(entry.tD, entry.pD, validTD);
+    QVector<double> deriv = CurveInterpolator::pchipLogLog(entry.tD, entry.deriv, validTD);
+    for (int j = 0; j < validIndex.size(); ++j) {
+        outPD[validIndex[j]] = pD[j];
+        outDeriv[validIndex[j]] = deriv[j];
+    }
+    return true;
+}
+
+// 参数灵敏度：拉普拉斯函数以对偶数求值，其余环节 (井储表皮、反演、压敏修正、换算系数) 按链式法则解析求导，
+// 所得偏导是数值解 (给定反演方法与阶数) 本身的偏导，与有限差分的极限一致
+ModelCurveSensitivity ModelSolver01_06::calculateSensitivities(const ModelParams& params, const QVector<ModelParams::Index>& which,
+                                                               const QVector<double>& providedTime, const SolverContext& context)
+{
+    QVector<double> tPoints = providedTime;
+    if (tPoints.isEmpty()) {
+        tPoints = generateLogTimeSteps(100, -3.0, 3.0);
+    }
+    int numPoints = tPoints.size();
+    int nParams = which.size();
+
+    double td_coeff, p_coeff;
+    dimensionlessCoefficients(params, td_coeff, p_coeff);
+    QVector<double> tD(numPoints);
+    for (int i = 0; i < numPoints; ++i) tD[i] = td_coeff * tPoints[i];
+
+    const SolverSettings& settings = context.settings;
+    const LaplaceInversion::Table& tab = LaplaceInversion::table(settings.inversion, inversionOrder(settings, params));
+    int nNodes = tab.nodes.size();
+    int numTasks = numPoints * nNodes;
+    LaplaceParams lp = makeLaplaceParams(params);
+
+    // 1. 各参数对中间量的偏导；只有被某个参数用到的方向以对偶数传播
+    QVector<ParameterChain> chains(nParams);
+    bool used[kDualDirections] = {};
+    for (int j = 0; j < nParams; ++j) {
+        chains[j] = parameterChain(params, which[j], m_type);
+        for (int d = 0; d < DirS; ++d) {
+            if (chains[j].laplace[d] != 0.0) used[d] = true;
+        }
+        if (chains[j].lnTd != 0.0) used[DirS] = true;
+    }
+    QVector<int> directions;
+    for (int d = 0; d < kDualDirections; ++d) {
+        if (used[d]) directions.append(d);
+    }
+    int nDir = directions.size();
+    int slotS = directions.indexOf(DirS);
+
+    // 2. 不含井储的拉普拉斯函数值及其偏导 (对偶数长度取不小于方向数的 2 的幂)
+    QVector<Complex> raw(numTasks, Complex(0.0, 0.0));
+    QVector<QVector<Complex>> rawDer(nDir, QVector<Complex>(numTasks, Complex(0.0, 0.0)));
+    bool completed = (nDir <= 2) ? evaluateLaplaceDual<2>(tD, tab, lp, directions, context, raw, rawDer)
+                   : (nDir <= 4) ? evaluateLaplaceDual<4>(tD, tab, lp, directions, context, raw, rawDer)
+                                 : evaluateLaplaceDual<8>(tD, tab, lp, directions, context, raw, rawDer);
+    if (!completed) return ModelCurveSensitivity();
+
+    // 3. 叠加井储表皮并逐点反演
+    bool analytic = settings.analyticDerivative;
+    double gamaD = params.value(ModelParams::GamaD, 0.0);
+    QVector<double> pD(numPoints, 0.0), deriv(numPoints, 0.0);
+    QVector<QVector<double>> dPD(nParams, QVector<double>(numPoints, 0.0));
+    QVector<QVector<double>> dDeriv(nParams, QVector<double>(numPoints, 0.0));
+    QVector<Complex> F(nNodes), Fs(nNodes), scaledF(nNodes), buf(nNodes);
+    QVector<Complex> dF(nParams * nNodes);
+
+    for (int k = 0; k < numPoints; ++k) {
+        double t = tD[k];
+        if (t <= 1e-12) continue;
+
+        for (int m = 0; m < nNodes; ++m) {
+            int task = k * nNodes + m;
+            Complex z = tab.nodes[m] / t;
+            Complex P = raw[task];
+            Complex value = tab.complexNodes ? applyStorageSkin<Complex>(z, P, lp)
+                                             : Complex(applyStorageSkin<double>(z.real(), P.real(), lp));
+            bool finite = isFiniteValue(value);
+            F[m] = finite ? value : Complex(0.0);
+
+            // 井储表皮 g = u / den (u = z*P + S，den = z + cD*z^2*u) 的偏导；cD = S = 0 时取极限 g = P
+            Complex u = z * P + lp.S;
+            Complex den = z + lp.cD * z * z * u;
+            Complex den2 = den * den;
+            Complex gP = z * z / den2;
+            Complex gS = z / den2;
+            Complex gCD = -z * z * u * u / den2;
+            Complex gZ = (P * den - u * (1.0 + 2.0 * lp.cD * z * u + lp.cD * z * z * P)) / den2;
+            Complex dFds = gZ + gP * (slotS >= 0 ? rawDer[slotS][task] : Complex(0.0));
+            Fs[m] = (finite && isFiniteValue(dFds)) ? dFds : Complex(0.0);
+
+            for (int j = 0; j < nParams; ++j) {
+                const ParameterChain& c = chains[j];
+                Complex dP(0.0, 0.0);
+                for (int i = 0; i < nDir; ++i) {
+                    if (directions[i] != DirS) dP += c.laplace[directions[i]] * rawDer[i][task];
+                }
+                Complex v = gP * dP + gS * c.S + gCD * c.cD;
+                dF[j * nNodes + m] = (finite && isFiniteValue(v)) ? v : Complex(0.0);
+            }
+        }
+
+        pD[k] = LaplaceInversion::invert(tab, t, F.constData());
+        if (analytic) {
+            for (int m = 0; m < nNodes; ++m) scaledF[m] = tab.nodes[m] * F[m];
+            deriv[k] = LaplaceInversion::invert(tab, t, scaledF.constData());
+        }
+
+        // tD = td_coeff * t 整体缩放：节点 s = alpha/tD 随之移动，d/dln(tD) 对应节点值方向 -(F + s*dF/ds)
+        // (反演结果对节点值为一次齐次，1/tD 因子的贡献 -pD 并入 -F 项)
+        double pScale = 0.0, dScale = 0.0;
+        if (slotS >= 0) {
+            for (int m = 0; m < nNodes; ++m) buf[m] = -(F[m] + tab.nodes[m] / t * Fs[m]);
+            pScale = LaplaceInversion::invertDerivative(tab, t, F.constData(), buf.constData());
+            if (analytic) {
+                for (int m = 0; m < nNodes; ++m) buf[m] *= tab.nodes[m];
+                dScale = LaplaceInversion::invertDerivative(tab, t, scaledF.constData(), buf.constData());
+            }
+        }
+
+        for (int j = 0; j < nParams; ++j) {
+            const Complex* dFj = dF.constData() + j * nNodes;
+            dPD[j][k] = LaplaceInversion::invertDerivative(tab, t, F.constData(), dFj) + chains[j].lnTd * pScale;
+            if (analytic) {
+                for (int m = 0; m < nNodes; ++m) buf[m] = tab.nodes[m] * dFj[m];
+                dDeriv[j][k] = LaplaceInversion::invertDerivative(tab, t, scaledF.constData(), buf.constData())
+                             + chains[j].lnTd * dScale;
+            }
+        }
+
+        // 压敏修正 pD' = -ln(1 - gamaD*pD)/gamaD 的链式法则 (与 invertLaplaceValues 的判断条件一致)
+        if (std::abs(gamaD) > 1e-9) {
+            double arg = 1.0 - gamaD * pD[k];
+            if (arg > 1e-12) {
+                double transformed = -1.0 / gamaD * std::log(arg);
+                for (int j = 0; j < nParams; ++j) {
+                    double dp = dPD[j][k];
+                    double dg = chains[j].gamaD;
+                    if (analytic) dDeriv[j][k] = dDeriv[j][k] / arg + deriv[k] * (gamaD * dp + dg * pD[k]) / (arg * arg);
+                    dPD[j][k] = dp / arg + dg * (pD[k] / arg - transformed) / gamaD;
+                }
+                if (analytic) deriv[k] /= arg;
+                pD[k] = transformed;
+            }
+        } else {
+            // gamaD -> 0 的极限: d/dgamaD = pD^2 / 2 (压力)，pD * deriv (解析导数)
+            for (int j = 0; j < nParams; ++j) {
+                double dg = chains[j].gamaD;
+                if (dg == 0.0) continue;
+                if (analytic) dDeriv[j][k] += dg * pD[k] * deriv[k];
+                dPD[j][k] += dg * 0.5 * pD[k] * pD[k];
+            }
+        }
+    }
+
+    // 4. Bourdet 导数只依赖对数时间差，与 td_coeff 无关，偏导由压力偏导经同一差分格式得到
+    if (!analytic && numPoints > 2) {
+        deriv = PressureDerivativeCalculator::calculateBourdetDerivative(tD, pD, 0.1);
+        for (int j = 0; j < nParams; ++j) {
+            dDeriv[j] = PressureDerivativeCalculator::calculateBourdetDerivativeSensitivity(tD, pD, dPD[j], 0.1);
+        }
+    }
+
+    // 5. 换算为物理量：dp = p_coeff * pD
+    ModelCurveSensitivity result;
+    result.curve = toPhysicalCurve(tPoints, pD, deriv, p_coeff);
+    result.params = which;
+    result.dP.resize(nParams);
+    result.dDeriv.resize(nParams);
+    for (int j = 0; j < nParams; ++j) {
+        result.dP[j].resize(numPoints);
+        result.dDeriv[j].resize(numPoints);
+        for (int i = 0; i < numPoints; ++i) {
+            result.dP[j][i] = p_coeff * (dPD[j][i] + chains[j].lnP * pD[i]);
+            result.dDeriv[j][i] = p_coeff * (dDeriv[j][i] + chains[j].lnP * deriv[i]);
+        }
+    }
+    return result;
+}
+
+// 以对偶数计算各 (时间点, 节点) 处不含井储的拉普拉斯函数值及其偏导
+template<int N>
+bool ModelSolver01_06::evaluateLaplaceDual(const QVector<double>& tD, const LaplaceInversion::Table& tab, const LaplaceParams& lp,
+                                           const QVector<int>& directions, const SolverContext& context,
+                                           QVector<Complex>& raw, QVector<QVector<Complex>>& rawDer)
+{
+    using RealDual = Dual<double, N>;
+    using ComplexDual = Dual<Complex, N>;
+    int nNodes = tab.nodes.size();
+    int numTasks = tD.size() * nNodes;
+    int nDir = directions.size();
+    int slotS = directions.indexOf(DirS);
+
+    // 参数对偶数只构造一次，各任务只读共享
+    auto seed = [&](auto& out) {
+        using D = typename std::decay<decltype(out.M12)>::type;
+        auto param = [&](double value, int direction) {
+            int slot = directions.indexOf(direction);
+            return (slot >= 0) ? D::variable(value, slot) : D(value);
+        };
+        out.M12 = param(lp.M12, DirM12);
+        out.LfD = param(lp.LfD, DirLfD);
+        out.rmD = param(lp.rmD, DirRmD);
+        out.reD = param(lp.reD, DirReD);
+        out.omega1 = param(lp.omega1, DirOmega1);
+        out.omega2 = param(lp.omega2, DirOmega2);
+        out.lambda1 = param(lp.lambda1, DirLambda1);
+        out.cD = lp.cD;
+        out.S = lp.S;
+        out.nf = lp.nf;
+        out.xwD = lp.xwD;
+    };
+    LaplaceParamsT<RealDual> lpReal;
+    LaplaceParamsT<ComplexDual> lpComplex;
+    if (tab.complexNodes) seed(lpComplex);
+    else seed(lpReal);
+
+    Complex* rawOut = raw.data();
+    QVector<Complex*> derOut(nDir);
+    for (int i = 0; i < nDir; ++i) derOut[i] = rawDer[i].data();
+
+    auto evaluate = [&](int task) {
+        double t = tD[task / nNodes];
+        if (t <= 1e-12 || isCancelled(context)) return;
+        int m = task % nNodes;
+        if (nDir == 0) {
+            rawOut[task] = laplaceAtNode(tab, m, t, lp);
+        } else if (tab.complexNodes) {
+            Complex s = tab.nodes[m] / t;
+            ComplexDual f = flaplace_composite<ComplexDual>(slotS >= 0 ? ComplexDual::variable(s, slotS) : ComplexDual(s), lpComplex);
+            rawOut[task] = f.val;
+            for (int i = 0; i < nDir; ++i) derOut[i][task] = f.der[i];
+        } else {
+            double s = tab.nodes[m].real() / t;
+            RealDual f = flaplace_composite<RealDual>(slotS >= 0 ? RealDual::variable(s, slotS) : RealDual(s), lpReal);
+            rawOut[task] = f.val;
+            for (int i = 0; i < nDir; ++i) derOut[i][task] = f.der[i];
+        }
+    };
+
+    if (context.parallel && threadCount() > 1 && numTasks > 1) {
+        QVector<int> tasks(numTasks);
+        for (int i = 0; i < numTasks; ++i) tasks[i] = i;
+        QtConcurrent::blockingMap(computePool(), tasks, [&](int& task) { evaluate(task); });
+    } else {
+        for (int i = 0; i < numTasks; ++i) evaluate(i);
+    }
+    return !isCancelled(context);
+}
+
+// 提取拉普拉斯空间参数 (每条曲线一次)
+ModelSolver01_06::LaplaceParams ModelSolver01_06::makeLaplaceParams(const ModelParams& p) const {
+    LaplaceParams lp;
+    double kf = p.value(ModelParams::Kf);
+    double km = p.value(ModelParams::Km);
 
     // [修改] 强制计算无因次缝长 LfD = Lf / L
     // 即使传入了参数 map，也优先使用 Lf 和 L 计算 LfD，确保数据一致性
-    double L = p.value("L");
-    double Lf = p.value("Lf");
-    double LfD = 0.0;
+    double L = p.value(ModelParams::L);
+    double Lf = p.value(ModelParams::Lf);
     if (L > 1e-9) {
-        LfD = Lf / L;
+        lp.LfD = Lf / L;
     } else {
-        LfD = p.value("LfD"); // 如果 L 无效，回退到参数值
+        lp.LfD = p.value(ModelParams::LfD); // 如果 L 无效，回退到参数值
     }
 
-    double rmD = p.value("rmD");
-    double reD = p.value("reD", 0.0);
-    double omga1 = p.value("omega1");
-    double omga2 = p.value("omega2");
-    double remda1 = p.value("lambda1");
-    int nf = (int)p.value("nf", 4);
-    if(nf < 1) nf = 1;
+    lp.rmD = p.value(ModelParams::RmD);
+    lp.reD = p.value(ModelParams::ReD, 0.0);
+    lp.omega1 = p.value(ModelParams::Omega1);
+    lp.omega2 = p.value(ModelParams::Omega2);
+    lp.lambda1 = p.value(ModelParams::Lambda1);
+    lp.nf = (int)p.value(ModelParams::Nf, 4);
+    if(lp.nf < 1) lp.nf = 1;
 
-    double M12 = kf / km;
+    lp.M12 = kf / km;
+
+    // 井储和表皮 (仅变井储模型使用)
+    bool hasStorage = (m_type == Model_1 || m_type == Model_3 || m_type == Model_5);
+    if (hasStorage) {
+        lp.cD = p.value(ModelParams::CD, 0.0);
+        lp.S = p.value(ModelParams::S, 0.0);
+    }
 
     // 生成裂缝位置 xwD
-    QVector<double> xwD;
-    if (nf == 1) {
-        xwD.append(0.0);
+    if (lp.nf == 1) {
+        lp.xwD.append(0.0);
     } else {
         double start = -0.9;
         double end = 0.9;
-        double step = (end - start) / (nf - 1);
-        for(int i=0; i<nf; ++i) xwD.append(start + i * step);
+        double step = (end - start) / (lp.nf - 1);
+        for(int i=0; i<lp.nf; ++i) lp.xwD.append(start + i * step);
     }
+    return lp;
+}
 
-    double temp = omga2;
-    double fs1 = omga1 + remda1 * temp / (remda1 + z * temp);
-    double fs2 = M12 * temp;
+// 拉普拉斯空间下的复合模型函数 (不含井储和表皮)
+template<typename T>
+T ModelSolver01_06::flaplace_composite(T z, const LaplaceParamsT<ParamOf<T>>& lp) {
+    ParamOf<T> temp = lp.omega2;
+    T fs1 = lp.omega1 + lp.lambda1 * temp / (lp.lambda1 + z * temp);
+    T fs2 = lp.M12 * temp;
 
-    // 计算不含井储的拉普拉斯空间压力
-    double pf = PWD_composite(z, fs1, fs2, M12, LfD, rmD, reD, nf, xwD, m_type);
+    return PWD_composite<T>(z, fs1, fs2, lp.M12, lp.LfD, lp.rmD, lp.reD, lp.nf, lp.xwD, m_type);
+}
 
-    // 加入井储和表皮效应
-    bool hasStorage = (m_type == Model_1 || m_type == Model_3 || m_type == Model_5);
-    if (hasStorage) {
-        double CD = p.value("cD", 0.0);
-        double S = p.value("S", 0.0);
-        if (CD > 1e-12 || std::abs(S) > 1e-12) {
-            pf = (z * pf + S) / (z + CD * z * z * (z * pf + S));
+// 加入井储和表皮效应
+template<typename T>
+T ModelSolver01_06::applyStorageSkin(T z, T pf, const LaplaceParams& lp) const {
+    double CD = lp.cD;
+    double S = lp.S;
+    if (CD > 1e-12 || std::abs(S) > 1e-12) {
+        pf = (z * pf + S) / (z + CD * z * z * (z * pf + S));
+    }
+    return pf;
+}
+
+// 缓存键：决定不含井储解的全部输入
+QVector<double> ModelSolver01_06::laplaceCacheKey(const LaplaceParams& lp, const LaplaceInversion::Table& tab, const QVector<double>& tD,
+                                                  bool interpolated) const {
+    QVector<double> key;
+    key.reserve(11 + tD.size());
+    key << lp.M12 << lp.LfD << lp.rmD << lp.reD << lp.omega1 << lp.omega2 << lp.lambda1
+        << double(lp.nf) << double(tab.method) << double(tab.order) << (interpolated ? 1.0 : 0.0);
+    for (double t : tD) key << t;
+    return key;
+}
+
+// 曲线缓存键：决定无因次曲线形状的全部参数 (不含 tD 序列)
+// 射线插值的曲线只是近似，标志与容限都进入键，不会被当作精确路径的结果取用
+QVector<double> ModelSolver01_06::curveCacheKey(const LaplaceParams& lp, double gamaD, const LaplaceInversion::Table& tab,
+                                                bool analyticDerivative, bool interpolateLaplace) const {
+    QVector<double> key;
+    key.reserve(16);
+    key << lp.M12 << lp.LfD << lp.rmD << lp.reD << lp.omega1 << lp.omega2 << lp.lambda1
+        << double(lp.nf) << lp.cD << lp.S << gamaD << double(tab.method) << double(tab.order)
+        << (analyticDerivative ? 1.0 : 0.0) << (interpolateLaplace ? 1.0 : 0.0)
+        << (interpolateLaplace ? rayInterpolationTolerance(tab) : 0.0);
+    return key;
+}
+
+bool ModelSolver01_06::lookupLaplaceCache(const QVector<double>& key, QVector<Complex>& values) {
+    QMutexLocker locker(&m_cacheMutex);
+    for (int i = 0; i < m_laplaceCache.size(); ++i) {
+        if (m_laplaceCache[i].key == key) {
+            values = m_laplaceCache[i].values;
+            if (i > 0) m_laplaceCache.move(i, 0);
+            return true;
         }
     }
+    return false;
+}
 
-    return pf;
+void ModelSolver01_06::storeLaplaceCache(const QVector<double>& key, const QVector<Complex>& values) {
+    QMutexLocker locker(&m_cacheMutex);
+    LaplaceCacheEntry entry;
+    entry.key = key;
+    entry.values = values;
+    m_laplaceCache.prepend(entry);
+    while (m_laplaceCache.size() > kLaplaceCacheSize) m_laplaceCache.removeLast();
 }
 
 // 核心点源解叠加计算
-double ModelSolver01_06::PWD_composite(double z, double fs1, double fs2, double M12, double LfD, double rmD, double reD, int nf, const QVector<double>& xwD, ModelType type) {
-    using namespace boost::math;
-    QVector<double> ywD(nf, 0.0); // 假设裂缝在y方向无偏移
-    double gama1 = sqrt(z * fs1);
-    double gama2 = sqrt(z * fs2);
-    double arg_g2_rm = gama2 * rmD;
-    double arg_g1_rm = gama1 * rmD;
-
-    double k0_g2 = cyl_bessel_k(0, arg_g2_rm);
-    double k1_g2 = cyl_bessel_k(1, arg_g2_rm);
-    double k0_g1 = cyl_bessel_k(0, arg_g1_rm);
-    double k1_g1 = cyl_bessel_k(1, arg_g1_rm);
-
-    double term_mAB_i0 = 0.0;
-    double term_mAB_i1 = 0.0;
+template<typename T>
+T ModelSolver01_06::PWD_composite(T z, T fs1, T fs2, ParamOf<T> M12, ParamOf<T> LfD, ParamOf<T> rmD, ParamOf<T> reD,
+                                  int nf, const QVector<double>& xwD, ModelType type) {
+    // 不加限定调用，对偶数时经参数相关查找使用 dualnumber.h 中的版本
+    using std::sqrt;
+    using std::exp;
+    using std::abs;
+    using std::real;
+    T gama1 = sqrt(z * fs1);
+    T gama2 = sqrt(z * fs2);
+    T arg_g2_rm = gama2 * rmD;
+    T arg_g1_rm = gama1 * rmD;
+
+    T k0_g2, k1_g2, i0_g2_s, i1_g2_s;
+    T k0_g1, k1_g1, i0_g1_s, i1_g1_s;
+    besselKI(arg_g2_rm, k0_g2, k1_g2, i0_g2_s, i1_g2_s);
+    besselKI(arg_g1_rm, k0_g1, k1_g1, i0_g1_s, i1_g1_s);
+
+    T term_mAB_i0 = 0.0;
+    T term_mAB_i1 = 0.0;
 
     bool isInfinite = (type == Model_1 || type == Model_2);
     bool isClosed = (type == Model_3 || type == Model_4);
@@ -242,110 +1140,335 @@ double ModelSolver01_06::PWD_composite(double z, double fs1, double fs2, double
 
     // 边界条件处理
     if (!isInfinite) {
-        double arg_re = gama2 * reD;
-        double i1_re_s = scaled_besseli(1, arg_re);
-        double i0_re_s = scaled_besseli(0, arg_re);
-        double k1_re = cyl_bessel_k(1, arg_re);
-        double k0_re = cyl_bessel_k(0, arg_re);
-        double i0_g2_s = scaled_besseli(0, arg_g2_rm);
-        double i1_g2_s = scaled_besseli(1, arg_g2_rm);
+        T arg_re = gama2 * reD;
+        T k0_re, k1_re, i0_re_s, i1_re_s;
+        besselKI(arg_re, k0_re, k1_re, i0_re_s, i1_re_s);
 
         if (isClosed) {
-            if (i1_re_s > 1e-100) {
-                term_mAB_i0 = (k1_re / i1_re_s) * i0_g2_s * std::exp(arg_g2_rm - arg_re);
-                term_mAB_i1 = (k1_re / i1_re_s) * i1_g2_s * std::exp(arg_g2_rm - arg_re);
+            if (abs(i1_re_s) > 1e-100) {
+                term_mAB_i0 = (k1_re / i1_re_s) * i0_g2_s * exp(arg_g2_rm - arg_re);
+                term_mAB_i1 = (k1_re / i1_re_s) * i1_g2_s * exp(arg_g2_rm - arg_re);
             }
         } else if (isConstP) {
-            if (i0_re_s > 1e-100) {
-                term_mAB_i0 = -(k0_re / i0_re_s) * i0_g2_s * std::exp(arg_g2_rm - arg_re);
-                term_mAB_i1 = -(k0_re / i0_re_s) * i1_g2_s * std::exp(arg_g2_rm - arg_re);
+            if (abs(i0_re_s) > 1e-100) {
+                term_mAB_i0 = -(k0_re / i0_re_s) * i0_g2_s * exp(arg_g2_rm - arg_re);
+                term_mAB_i1 = -(k0_re / i0_re_s) * i1_g2_s * exp(arg_g2_rm - arg_re);
             }
         }
     }
 
-    double term1 = term_mAB_i0 + k0_g2;
-    double term2 = term_mAB_i1 - k1_g2;
+    T term1 = term_mAB_i0 + k0_g2;
+    T term2 = term_mAB_i1 - k1_g2;
 
-    double Acup = M12 * gama1 * k1_g1 * term1 + gama2 * k0_g1 * term2;
+    T Acup = M12 * gama1 * k1_g1 * term1 + gama2 * k0_g1 * term2;
 
-    double i1_g1_s = scaled_besseli(1, arg_g1_rm);
-    double i0_g1_s = scaled_besseli(0, arg_g1_rm);
+    T Acdown_scaled = M12 * gama1 * i1_g1_s * term1 - gama2 * i0_g1_s * term2;
 
-    double Acdown_scaled = M12 * gama1 * i1_g1_s * term1 - gama2 * i0_g1_s * term2;
+    if (abs(Acdown_scaled) < 1e-100) Acdown_scaled = 1e-100;
 
-    if (std::abs(Acdown_scaled) < 1e-100) Acdown_scaled = 1e-100;
+    T Ac_prefactor = Acup / Acdown_scaled;
 
-    double Ac_prefactor = Acup / Acdown_scaled;
+    // 积分核自变量下限：|gama1 * dist| 不小于 1e-10 (实数时即 arg_dist >= 1e-10)
+    double absGama1 = abs(gama1);
+    double minDist = (absGama1 > 0.0) ? 1e-10 / absGama1 : 0.0;
 
-    // 建立线性方程组求解裂缝各段流量分布
-    int size = nf + 1;
-    Eigen::MatrixXd A_mat(size, size);
-    Eigen::VectorXd b_vec(size);
-    b_vec.setZero();
-    b_vec(nf) = 1.0; // 定产条件
+    // 单条裂缝对偏移 offset 处裂缝的影响积分 (沿裂缝积分)
+    auto influence = [&](double offset) -> T {
+        // 一次计算一个区间的全部积分节点
+        auto integrand = [&](const double* a, int n, T* out) {
+            T arg_dist[GaussKronrod::NodeCount], k0[GaussKronrod::NodeCount], i0s[GaussKronrod::NodeCount];
+            for (int i = 0; i < n; ++i) {
+                double dist = std::abs(offset - a[i]);
+                arg_dist[i] = (dist < minDist) ? T(1e-10) * (gama1 / absGama1) : gama1 * dist;
+            }
+            besselK0I0Batch(arg_dist, n, k0, i0s);
+            for (int i = 0; i < n; ++i) {
+                T term2 = 0.0;
+                T exponent = arg_dist[i] - arg_g1_rm;
+                if (real(exponent) > -700.0) {
+                    term2 = Ac_prefactor * i0s[i] * exp(exponent);
+                }
+                out[i] = k0[i] + term2;
+            }
+        };
 
-    for (int i = 0; i < nf; ++i) {
-        for (int j = 0; j < nf; ++j) {
-            auto integrand = [&](double a) -> double {
-                double dist = std::sqrt(std::pow(xwD[i] - xwD[j] - a, 2) + std::pow(ywD[i] - ywD[j], 2));
-                double arg_dist = gama1 * dist;
-                if (arg_dist < 1e-10) arg_dist = 1e-10;
+        // 积分核在 a = offset 处有对数奇点，奇点位于裂缝内部时分两段积分，误差限按长度分配
+        const double absTol = 1e-5, relTol = 1e-10;
+        const double lfd = DualTraits<ParamOf<T>>::realValue(LfD);
+        T val;
+        if (offset > -lfd && offset < lfd) {
+            double wL = (offset + lfd) / (2 * lfd);
+            val = GaussKronrod::integrateBatch<T>(integrand, -lfd, offset, absTol * wL, relTol).value
+                + GaussKronrod::integrateBatch<T>(integrand, offset, lfd, absTol * (1.0 - wL), relTol).value;
+        } else {
+            val = GaussKronrod::integrateBatch<T>(integrand, -lfd, lfd, absTol, relTol).value;
+        }
+        if constexpr (DualTraits<T>::isDual) {
+            // 积分限 ±LfD 随参数变化 (Leibniz 公式)：d/dθ ∫ f = ∫ df/dθ + (f(LfD) + f(-LfD)) * dLfD/dθ
+            double ends[2] = {-lfd, lfd};
+            T fe[2];
+            integrand(ends, 2, fe);
+            for (int k = 0; k < T::Size; ++k) val.der[k] += (fe[0].val + fe[1].val) * LfD.der[k];
+        }
+        return val / (M12 * 2 * LfD);
+    };
 
-                double term2 = 0.0;
-                double exponent = arg_dist - arg_g1_rm;
-                if (exponent > -700.0) {
-                    term2 = Ac_prefactor * scaled_besseli(0, arg_dist) * std::exp(exponent);
-                }
-                return cyl_bessel_k(0, arg_dist) + term2;
-            };
-            // 沿裂缝积分
-            double val = adaptiveGauss(integrand, -LfD, LfD, 1e-5, 0, 10);
-            A_mat(i, j) = z * val / (M12 * z * 2 * LfD);
+    // 检查裂缝是否等间距分布 (ywD 恒为 0，裂缝位于同一直线上)
+    double step = (nf > 1) ? (xwD[1] - xwD[0]) : 0.0;
+    bool isUniform = true;
+    for (int i = 1; i < nf; ++i) {
+        if (std::abs((xwD[i] - xwD[i - 1]) - step) > 1e-12 * (1.0 + std::abs(step))) {
+            isUniform = false;
+            break;
+        }
+    }
+
+    // 求解 A * y = 1，其中 A 为裂缝间影响系数矩阵
+    // 由定压条件 (各裂缝压力相等) 与定产条件 (z * 流量和 = 1) 可知:
+    // 流量 q = pwD * y，且 pwD = 1 / (z * sum(y))
+    T sumY;
+    if constexpr (DualTraits<T>::isDual) {
+        sumY = fractureFluxSumDual<T>(nf, xwD, isUniform, step, influence);
+    } else {
+        sumY = FractureCountDispatch<kMaxFixedFractures>::run(nf, [&](auto size) {
+            return fractureFluxSum<decltype(size)::value, T>(nf, xwD, isUniform, step, influence);
+        });
+    }
+    if (abs(sumY) < 1e-300) sumY = 1e-300;
+
+    return T(1.0) / (z * sumY);
+}
+
+// 求解裂缝流量方程组并返回 sum(y)
+// N 为编译期矩阵大小 (等于 nf)，Eigen::Dynamic 表示运行期大小；定长时不做堆分配
+template<int N, typename T, typename Influence>
+T ModelSolver01_06::fractureFluxSum(int nf, const QVector<double>& xwD, bool isUniform, double step, const Influence& influence)
+{
+    using MatrixT = Eigen::Matrix<T, N, N>;
+    using VectorT = Eigen::Matrix<T, N, 1>;
+
+    // 稠密求解：定长时部分选主元 LU (影响系数矩阵对角占优)，动态大小沿用全选主元 LU
+    auto denseSolve = [nf](const MatrixT& A, VectorT& y) {
+        VectorT ones;
+        ones.setConstant(nf, T(1.0));
+        if constexpr (N == Eigen::Dynamic) {
+            y = A.fullPivLu().solve(ones);
+        } else {
+            y = A.partialPivLu().solve(ones);
+        }
+    };
+
+    VectorT y;
+    y.resize(nf);
+    bool solved = false;
+
+    if (isUniform) {
+        // 等间距裂缝：影响系数仅取决于间距 |i-j|，系数矩阵为对称 Toeplitz 矩阵，
+        // 只需计算 nf 个不同间距的积分，再用 Levinson 递推求解 (O(nf^2))
+        VectorT tCol, ones;
+        tCol.resize(nf);
+        for (int d = 0; d < nf; ++d) {
+            tCol(d) = influence(d * step);
+        }
+        ones.setConstant(nf, T(1.0));
+        solved = solveSymmetricToeplitz(tCol, ones, y);
+        if (!solved) {
+            // Levinson 递推出现奇异主子式时退回稠密 LU 分解
+            MatrixT A_mat;
+            A_mat.resize(nf, nf);
+            for (int i = 0; i < nf; ++i) {
+                for (int j = 0; j < nf; ++j) A_mat(i, j) = tCol(std::abs(i - j));
+            }
+            denseSolve(A_mat, y);
+            solved = true;
         }
     }
-    // 补充方程：各裂缝压力相等，流量和为1
-    for (int i = 0; i < nf; ++i) {
-        A_mat(i, nf) = -1.0;
-        A_mat(nf, i) = z;
+
+    if (!solved) {
+        // 非等间距裂缝：逐对计算影响系数并稠密求解
+        MatrixT A_mat;
+        A_mat.resize(nf, nf);
+        for (int i = 0; i < nf; ++i) {
+            for (int j = 0; j < nf; ++j) {
+                A_mat(i, j) = influence(xwD[i] - xwD[j]);
+            }
+        }
+        denseSolve(A_mat, y);
     }
-    A_mat(nf, nf) = 0.0;
 
-    return A_mat.fullPivLu().solve(b_vec)(nf);
+    T sumY = 0.0;
+    for (int i = 0; i < nf; ++i) sumY += y(i);
+    return sumY;
 }
 
-double ModelSolver01_06::scaled_besseli(int v, double x) {
-    if (x < 0) x = -x;
-    if (x > 600.0) return 1.0 / std::sqrt(2.0 * M_PI * x);
-    return boost::math::cyl_bessel_i(v, x) * std::exp(-x);
+// 对偶数版本：A(θ) * y = 1 两边求偏导得 A0 * dy = -dA * y0，各方向与函数值共用 A0 的 Levinson 递推或 LU 分解
+template<typename D, typename Influence>
+D ModelSolver01_06::fractureFluxSumDual(int nf, const QVector<double>& xwD, bool isUniform, double step, const Influence& influence)
+{
+    using S = typename D::Scalar;
+    using MatrixS = Eigen::Matrix<S, Eigen::Dynamic, Eigen::Dynamic>;
+    using VectorS = Eigen::Matrix<S, Eigen::Dynamic, 1>;
+
+    // 影响系数 (等间距时只有 nf 个不同间距)
+    QVector<D> coeffs;
+    if (isUniform) {
+        coeffs.resize(nf);
+        for (int d = 0; d < nf; ++d) coeffs[d] = influence(d * step);
+    } else {
+        coeffs.resize(nf * nf);
+        for (int i = 0; i < nf; ++i) {
+            for (int j = 0; j < nf; ++j) coeffs[i * nf + j] = influence(xwD[i] - xwD[j]);
+        }
+    }
+    auto entry = [&](int i, int j) -> const D& {
+        return isUniform ? coeffs[std::abs(i - j)] : coeffs[i * nf + j];
+    };
+
+    VectorS ones = VectorS::Constant(nf, S(1.0));
+    VectorS col0, y0;
+    bool toeplitz = false;
+    if (isUniform) {
+        col0.resize(nf);
+        for (int d = 0; d < nf; ++d) col0(d) = coeffs[d].val;
+        toeplitz = solveSymmetricToeplitz(col0, ones, y0);
+    }
+    Eigen::PartialPivLU<MatrixS> lu;
+    if (!toeplitz) {
+        MatrixS A0(nf, nf);
+        for (int i = 0; i < nf; ++i) {
+            for (int j = 0; j < nf; ++j) A0(i, j) = entry(i, j).val;
+        }
+        lu.compute(A0);
+        y0 = lu.solve(ones);
+    }
+
+    D sumY;
+    for (int i = 0; i < nf; ++i) sumY.val += y0(i);
+    VectorS rhs(nf), dy;
+    for (int k = 0; k < D::Size; ++k) {
+        for (int i = 0; i < nf; ++i) {
+            S acc(0.0);
+            for (int j = 0; j < nf; ++j) acc += entry(i, j).der[k] * y0(j);
+            rhs(i) = -acc;
+        }
+        if (toeplitz) solveSymmetricToeplitz(col0, rhs, dy);
+        else dy = lu.solve(rhs);
+        for (int i = 0; i < nf; ++i) sumY.der[k] += dy(i);
+    }
+    return sumY;
 }
 
-double ModelSolver01_06::gauss15(std::function<double(double)> f, double a, double b) {
-    static const double X[] = { 0.0, 0.201194, 0.394151, 0.570972, 0.724418, 0.848207, 0.937299, 0.987993 };
-    static const double W[] = { 0.202578, 0.198431, 0.186161, 0.166269, 0.139571, 0.107159, 0.070366, 0.030753 };
-    double h = 0.5 * (b - a); double c = 0.5 * (a + b); double s = W[0] * f(c);
-    for (int i = 1; i < 8; ++i) { double dx = h * X[i]; s += W[i] * (f(c - dx) + f(c + dx)); }
-    return s * h;
+// 对称 Toeplitz 方程组求解 (Levinson 递推)
+// col 为矩阵第一列，返回 false 表示某一阶主子式奇异，需由调用者改用一般解法；
+// 中间向量与参数同类型 (定长 Eigen 向量时位于栈上)
+template<typename VectorT>
+bool ModelSolver01_06::solveSymmetricToeplitz(const VectorT& col, const VectorT& b, VectorT& x)
+{
+    using T = typename VectorT::Scalar;
+    int n = (int)col.size();
+    x.resize(n);
+    if (n == 0) return true;
+    T t0 = col(0);
+    if (std::abs(t0) < 1e-300) return false;
+
+    // 归一化为单位对角 Toeplitz 矩阵
+    VectorT r, rhs, yv, tmp;
+    r.resize(n);
+    rhs.resize(n);
+    yv.resize(n);
+    tmp.resize(n);
+    for (int k = 0; k < n; ++k) {
+        r(k) = col(k) / t0;
+        rhs(k) = b(k) / t0;
+    }
+
+    x(0) = rhs(0);
+    if (n == 1) return true;
+
+    yv(0) = -r(1);
+    T beta = 1.0;
+    T alpha = -r(1);
+
+    for (int k = 1; k < n; ++k) {
+        beta = (1.0 - alpha * alpha) * beta;
+        if (std::abs(beta) < 1e-14) return false;
+
+        // 更新解向量 x
+        T dot = 0.0;
+        for (int i = 0; i < k; ++i) dot += r(i + 1) * x(k - 1 - i);
+        T mu = (rhs(k) - dot) / beta;
+        for (int i = 0; i < k; ++i) tmp(i) = x(i) + mu * yv(k - 1 - i);
+        for (int i = 0; i < k; ++i) x(i) = tmp(i);
+        x(k) = mu;
+
+        // 更新 Yule-Walker 辅助向量 y
+        if (k < n - 1) {
+            T dotY = 0.0;
+            for (int i = 0; i < k; ++i) dotY += r(i + 1) * yv(k - 1 - i);
+            alpha = (-r(k + 1) - dotY) / beta;
+            for (int i = 0; i < k; ++i) tmp(i) = yv(i) + alpha * yv(k - 1 - i);
+            for (int i = 0; i < k; ++i) yv(i) = tmp(i);
+            yv(k) = alpha;
+        }
+    }
+    return true;
 }
 
-double ModelSolver01_06::adaptiveGauss(std::function<double(double)> f, double a, double b, double eps, int depth, int maxDepth) {
-    double c = (a + b) / 2.0; double v1 = gauss15(f, a, b); double v2 = gauss15(f, a, c) + gauss15(f, c, b);
-    if (depth >= maxDepth || std::abs(v1 - v2) < 1e-10 * std::abs(v2) + eps) return v2;
-    return adaptiveGauss(f, a, c, eps/2, depth+1, maxDepth) + adaptiveGauss(f, c, b, eps/2, depth+1, maxDepth);
+// 实数 Bessel 函数 (0/1 阶专用 Chebyshev 逼近)
+void ModelSolver01_06::besselKI(double x, double& k0, double& k1, double& i0s, double& i1s) {
+    k0 = BesselFunctions::k0(x);
+    k1 = BesselFunctions::k1(x);
+    i0s = BesselFunctions::i0e(x);
+    i1s = BesselFunctions::i1e(x);
 }
 
-double ModelSolver01_06::stefestCoefficient(int i, int N) {
-    double s = 0.0; int k1 = (i + 1) / 2; int k2 = std::min(i, N / 2);
-    for (int k = k1; k <= k2; ++k) {
-        double num = pow(k, N / 2.0) * factorial(2 * k);
-        double den = factorial(N / 2 - k) * factorial(k) * factorial(k - 1) * factorial(i - k) * factorial(2 * k - i);
-        if(den!=0) s += num/den;
+void ModelSolver01_06::besselK0I0Batch(const double* x, int n, double* k0, double* i0s) {
+    BesselFunctions::k0i0eBatch(x, k0, i0s, n);
+}
+
+// 复数 Bessel 函数 (BesselFunctions 返回缩放值，K 需乘 exp(-x) 还原)
+void ModelSolver01_06::besselKI(Complex x, Complex& k0, Complex& k1, Complex& i0s, Complex& i1s) {
+    Complex k0e, k1e;
+    BesselFunctions::all01e(x, k0e, k1e, i0s, i1s);
+    Complex emx = std::exp(-x);
+    k0 = k0e * emx;
+    k1 = k1e * emx;
+}
+
+void ModelSolver01_06::besselK0I0Batch(const Complex* x, int n, Complex* k0, Complex* i0s) {
+    for (int i = 0; i < n; ++i) {
+        Complex k0e, k1e, i1s;
+        BesselFunctions::all01e(x[i], k0e, k1e, i0s[i], i1s);
+        k0[i] = k0e * std::exp(-x[i]);
     }
-    return ((i + N / 2) % 2 == 0 ? 1.0 : -1.0) * s;
 }
 
-double ModelSolver01_06::factorial(int n) {
-    if(n<=1)return 1;
-    double r=1;
-    for(int i=2;i<=n;++i) r*=i;
-    return r;
+// 对偶数自变量：函数值由普通标量版本计算，偏导按 K0' = -K1，K1' = -K0 - K1/x，
+// (e^-x I0)' = e^-x I1 - e^-x I0，(e^-x I1)' = e^-x I0 - (1 + 1/x) e^-x I1 传播
+template<typename T, int N>
+void ModelSolver01_06::besselKI(const Dual<T, N>& x, Dual<T, N>& k0, Dual<T, N>& k1, Dual<T, N>& i0s, Dual<T, N>& i1s) {
+    T vk0, vk1, vi0, vi1;
+    besselKI(x.val, vk0, vk1, vi0, vi1);
+    T dk0 = -vk1;
+    T dk1 = -vk0 - vk1 / x.val;
+    T di0 = vi1 - vi0;
+    T di1 = vi0 - vi1 / x.val - vi1;
+    k0 = vk0;
+    k1 = vk1;
+    i0s = vi0;
+    i1s = vi1;
+    for (int j = 0; j < N; ++j) {
+        k0.der[j] = dk0 * x.der[j];
+        k1.der[j] = dk1 * x.der[j];
+        i0s.der[j] = di0 * x.der[j];
+        i1s.der[j] = di1 * x.der[j];
+    }
+}
+
+template<typename T, int N>
+void ModelSolver01_06::besselK0I0Batch(const Dual<T, N>* x, int n, Dual<T, N>* k0, Dual<T, N>* i0s) {
+    for (int i = 0; i < n; ++i) {
+        Dual<T, N> k1, i1s;
+        besselKI(x[i], k0[i], k1, i0s[i], i1s);
+    }
 }
@@ -3,8 +3,21 @@
  * 文件作用: 压裂水平井复合页岩油模型核心计算类头文件
  * 功能描述:
  * 1. 定义模型类型枚举 (ModelType) 和曲线数据类型 (ModelCurveData)。
- * 2. 声明纯数学计算逻辑，包括拉普拉斯变换、贝塞尔函数计算、Stehfest 数值反演等。
+ * 2. 声明纯数学计算逻辑，包括拉普拉斯变换、贝塞尔函数计算、数值反演等。
  * 3. 不依赖任何 UI 控件，仅负责数据输入与结果输出。
+ * 4. 定义求解配置 (SolverSettings)，可选择 Stehfest、固定 Talbot 或 de Hoog 反演方法及阶数。
+ * 5. 提供独立的计算线程池，时间点与反演节点的计算可并行执行，线程数可配置。
+ * 6. 计算接口以定长参数结构 ModelParams 为主，QMap 接口仅作为界面层的适配器。
+ * 7. 缓存不含井储/表皮的拉普拉斯函数值，只改变 cD、S 时跳过裂缝系统求解。
+ * 8. 可选的无因次曲线缓存：按决定曲线形状的无因次参数作键保存 (tD, pD, 导数)，
+ *    只改变 phi、mu、Ct、q、B、h 等换算系数时通过双对数插值直接给出结果 (用于交互预览)。
+ * 9. 可选解析导数：与 pD 在同一次反演中得到，时间点稀疏时不失真。
+ * 10. 可选射线插值：长时间序列下以自适应插值代替逐节点求解拉普拉斯函数。
+ * 11. 可重入：精度、反演方法/阶数与临时缓冲区随每次调用的 SolverContext 传入，求解器只保存受锁保护的默认配置与缓存，
+ *     同一求解器实例可被多个线程 (拟合、界面预览) 同时调用。
+ * 12. 批量接口：多组参数共享时间序列与反演节点表，各组的拉普拉斯求解任务合并后在计算线程池中并行。
+ * 13. 协作取消：上下文可携带取消标志与截止时间，求解器在每个 (时间点, 节点) 任务前检查，停止后返回空曲线且不写入缓存。
+ * 14. 参数灵敏度：拉普拉斯函数以对偶数 (dualnumber.h) 求值，一次求解同时得到压力、导数及其对模型参数的偏导 (拟合用解析雅可比)。
  */
 
 #ifndef MODELSOLVER01_06_H
@@ -13,12 +26,58 @@
 #include <QMap>
 #include <QVector>
 #include <QString>
+#include <QList>
+#include <QMutex>
+#include <QDeadlineTimer>
 #include <tuple>
+#include <complex>
 #include <functional>
+#include <atomic>
+
+#include "laplaceinversion.h"
+#include "modelparams.h"
+#include "dualnumber.h"
+
+class QThreadPool;
 
 // 类型定义: <时间, 压力, 导数>
 using ModelCurveData = std::tuple<QVector<double>, QVector<double>, QVector<double>>;
 
+// 理论曲线及其对模型参数的偏导: dP[j][i] 为压力在 t_i 处对 params[j] 的偏导，dDeriv 为压力导数曲线的偏导
+struct ModelCurveSensitivity {
+    ModelCurveData curve;
+    QVector<ModelParams::Index> params;
+    QVector<QVector<double>> dP;
+    QVector<QVector<double>> dDeriv;
+};
+
+// 求解配置: 计算精度、拉普拉斯数值反演方法与阶数
+struct SolverSettings {
+    bool highPrecision = true;  // 高精度模式 (拟合迭代时可关闭以提速)
+    LaplaceInversion::Method inversion = LaplaceInversion::Stehfest;
+    int order = 0;  // 反演阶数，0 表示按精度模式自动选择 (Stehfest 高精度时沿用参数 "N")
+    bool useCurveCache = false; // 使用无因次曲线缓存 + 双对数插值 (交互预览用，结果为插值近似)
+    bool analyticDerivative = false; // 导数由同一组拉普拉斯函数值解析反演，替代对 pD 做 Bourdet 差分
+    bool interpolateLaplace = false; // 时间点较多时沿反演节点射线插值拉普拉斯函数，减少求解次数
+};
+
+// 求解临时缓冲区：可跨调用复用以避免重复分配，同一时刻只能被一个调用使用
+struct SolverWorkspace {
+    QVector<double> tD;
+    QVector<std::complex<double>> raw;      // 不含井储的拉普拉斯函数值
+    QVector<std::complex<double>> values;   // 叠加井储/表皮后的函数值
+    QVector<std::complex<double>> scaled;   // 解析导数的反演输入
+};
+
+// 单次调用的求解上下文 (由调用者持有，求解器不保存调用间状态)
+struct SolverContext {
+    SolverSettings settings;
+    SolverWorkspace* workspace = nullptr;   // 为空时使用调用内部的临时缓冲区
+    bool parallel = true;   // 是否在计算线程池中并行展开 (时间点 × 节点) 任务
+    const std::atomic_bool* cancel = nullptr;   // 取消标志 (调用者可在任意线程置位)，为空时不可取消
+    QDeadlineTimer deadline = QDeadlineTimer(QDeadlineTimer::Forever);  // 截止时间，超时按取消处理
+};
+
 class ModelSolver01_06
 {
 public:
@@ -36,11 +95,42 @@ public:
     explicit ModelSolver01_06(ModelType type);
     virtual ~ModelSolver01_06();
 
-    // 设置计算精度
+    // 设置默认配置中的计算精度 (不影响显式传入上下文的调用)
     void setHighPrecision(bool high);
 
+    // 设置/获取默认求解配置 (精度、反演方法与阶数)，读写均加锁
+    void setSolverSettings(const SolverSettings& settings);
+    SolverSettings solverSettings() const;
+
     // 核心计算接口：根据参数和时间序列计算理论曲线
+    ModelCurveData calculateTheoreticalCurve(const ModelParams& params, const QVector<double>& providedTime = QVector<double>());
+
+    // 使用指定求解配置计算理论曲线 (不改变默认配置)
+    ModelCurveData calculateTheoreticalCurve(const ModelParams& params, const QVector<double>& providedTime, const SolverSettings& settings);
+
+    // 使用调用者的求解上下文计算理论曲线 (可重入，可在多个线程中同时调用)；被取消或超时时返回空曲线
+    ModelCurveData calculateTheoreticalCurve(const ModelParams& params, const QVector<double>& providedTime, const SolverContext& context);
+
+    // 批量计算：多组参数共享时间序列，结果顺序与输入一致。直接求解时各组的 (时间点 × 节点) 任务合并后一次并行，
+    // 各组使用独立缓冲区，context.workspace 不被使用；使用曲线缓存或射线插值时逐组计算、组内并行。
+    // 被取消时未完成的参数组返回空曲线
+    QVector<ModelCurveData> calculateTheoreticalCurves(const QVector<ModelParams>& paramsList, const QVector<double>& providedTime = QVector<double>());
+    QVector<ModelCurveData> calculateTheoreticalCurves(const QVector<ModelParams>& paramsList, const QVector<double>& providedTime, const SolverContext& context);
+
+    // 理论曲线及其对 which 中各参数的偏导 (前向自动微分，一次求解得到)。离散参数 (nf、N) 的偏导为零；
+    // 不使用曲线缓存与射线插值；被取消时返回空结果
+    ModelCurveSensitivity calculateSensitivities(const ModelParams& params, const QVector<ModelParams::Index>& which,
+                                                 const QVector<double>& providedTime, const SolverContext& context);
+
+    // QMap 参数适配接口 (界面层使用)
     ModelCurveData calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>());
+    ModelCurveData calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime, const SolverSettings& settings);
+
+    // 清空拉普拉斯函数值缓存
+    void clearLaplaceCache();
+
+    // 清空无因次曲线缓存
+    void clearCurveCache();
 
     // 获取模型名称（静态辅助函数）
     static QString getModelName(ModelType type);
@@ -48,28 +138,151 @@ public:
     // 生成对数时间步长（静态辅助函数，供内部或外部生成时间序列使用）
     static QVector<double> generateLogTimeSteps(int count, double startExp, double endExp);
 
+    // 计算线程池：与全局线程池分离，避免在拟合等后台任务中嵌套等待
+    static QThreadPool* computePool();
+    // 设置并行线程数 (1 表示串行计算，<= 0 表示使用全部核心)
+    static void setThreadCount(int count);
+    static int threadCount();
+
+    // 上下文是否要求停止 (取消标志已置位或已超过截止时间)
+    static bool isCancelled(const SolverContext& context);
+
 private:
-    // 计算无因次压力和导数
-    void calculatePDandDeriv(const QVector<double>& tD, const QMap<QString, double>& params,
-                             std::function<double(double, const QMap<QString, double>&)> laplaceFunc,
+    // 拉普拉斯空间计算所需的无因次参数 (每条曲线只提取一次)；P 为 double，求灵敏度时为携带偏导的对偶数
+    template<typename P>
+    struct LaplaceParamsT {
+        P M12 = 0.0;            // 内外区流度比 kf / km
+        P LfD = 0.0;            // 无因次缝长
+        P rmD = 0.0;
+        P reD = 0.0;
+        P omega1 = 0.0;
+        P omega2 = 0.0;
+        P lambda1 = 0.0;
+        double cD = 0.0;        // 井储与表皮只在最后一步进入
+        double S = 0.0;
+        int nf = 1;
+        QVector<double> xwD;    // 裂缝位置
+    };
+    using LaplaceParams = LaplaceParamsT<double>;
+
+    // 标量类型 T 对应的模型参数类型 (普通标量为 double，对偶数为同类型对偶数)
+    template<typename T>
+    using ParamOf = typename DualTraits<T>::Param;
+
+    // 不含井储/表皮的拉普拉斯函数值缓存项
+    struct LaplaceCacheEntry {
+        QVector<double> key;                    // 几何/储容参数 + 反演方法/阶数 + tD 序列
+        QVector<std::complex<double>> values;   // 各 (时间点, 节点) 处的函数值
+    };
+
+    // 无因次曲线缓存项 (tD 为覆盖请求范围并向两侧外扩的对数等距网格)
+    struct CurveCacheEntry {
+        QVector<double> key;    // 形状参数 + 反演方法/阶数
+        QVector<double> tD;
+        QVector<double> pD;
+        QVector<double> deriv;
+    };
+
+    // 无因次换算系数 (tD = tdCoeff * t，dp = pCoeff * pD) 与物理量曲线组装
+    static void dimensionlessCoefficients(const ModelParams& params, double& tdCoeff, double& pCoeff);
+    static ModelCurveData toPhysicalCurve(const QVector<double>& tPoints, const QVector<double>& PD,
+                                          const QVector<double>& deriv, double pCoeff);
+
+    // 计算无因次压力和导数，被取消时返回 false (输出无效)
+    bool calculatePDandDeriv(const QVector<double>& tD, const ModelParams& params,
+                             const SolverContext& context,
                              QVector<double>& outPD, QVector<double>& outDeriv);
 
-    // 拉普拉斯空间下的复合模型函数
-    double flaplace_composite(double z, const QMap<QString, double>& p);
+    // 经无因次曲线缓存计算：命中时插值，未命中时在网格上求解后写入缓存；被取消时返回 false
+    bool calculatePDandDerivCached(const QVector<double>& tD, const ModelParams& params,
+                                   const SolverContext& context,
+                                   QVector<double>& outPD, QVector<double>& outDeriv);
+
+    // 单个反演节点处不含井储的拉普拉斯函数值
+    std::complex<double> laplaceAtNode(const LaplaceInversion::Table& tab, int m, double t, const LaplaceParams& lp);
+
+    // 叠加井储表皮、逐点反演并计算导数 (raw 为不含井储的函数值，按 k * nNodes + m 存放)
+    void invertLaplaceValues(const QVector<double>& tD, const ModelParams& params,
+                             const LaplaceInversion::Table& tab, const LaplaceParams& lp,
+                             const QVector<std::complex<double>>& raw, const SolverSettings& settings,
+                             SolverWorkspace& ws, QVector<double>& outPD, QVector<double>& outDeriv) const;
+
+    // 以 N 个方向的对偶数计算不含井储的拉普拉斯函数值及其偏导 (directions[j] 为第 j 个方向对应的求导量)，
+    // raw 与 rawDer[j] 按 k * nNodes + m 存放；被取消时返回 false
+    template<int N>
+    bool evaluateLaplaceDual(const QVector<double>& tD, const LaplaceInversion::Table& tab, const LaplaceParams& lp,
+                             const QVector<int>& directions, const SolverContext& context,
+                             QVector<std::complex<double>>& raw, QVector<QVector<std::complex<double>>>& rawDer);
+
+    // 沿反演节点射线插值计算不含井储的拉普拉斯函数值 (raw 按 k * nNodes + m 存放)
+    void evaluateLaplaceInterpolated(const QVector<double>& tD, const LaplaceInversion::Table& tab,
+                                     const LaplaceParams& lp, const SolverContext& context,
+                                     QVector<std::complex<double>>& raw);
+
+    // 确定实际使用的反演阶数
+    int inversionOrder(const SolverSettings& settings, const ModelParams& params) const;
+
+    // 提取拉普拉斯空间参数
+    LaplaceParams makeLaplaceParams(const ModelParams& p) const;
+
+    // 拉普拉斯空间下的复合模型函数，不含井储和表皮 (T 为 double 或 std::complex<double>)
+    template<typename T>
+    T flaplace_composite(T z, const LaplaceParamsT<ParamOf<T>>& lp);
+
+    // 在不含井储的解上叠加井储和表皮效应
+    template<typename T>
+    T applyStorageSkin(T z, T pf, const LaplaceParams& lp) const;
+
+    // 缓存查找与写入 (线程安全)
+    QVector<double> laplaceCacheKey(const LaplaceParams& lp, const LaplaceInversion::Table& tab, const QVector<double>& tD,
+                                    bool interpolated) const;
+    bool lookupLaplaceCache(const QVector<double>& key, QVector<std::complex<double>>& values);
+    void storeLaplaceCache(const QVector<double>& key, const QVector<std::complex<double>>& values);
+    QVector<double> curveCacheKey(const LaplaceParams& lp, double gamaD, const LaplaceInversion::Table& tab,
+                                  bool analyticDerivative, bool interpolateLaplace) const;
 
     // 计算点源解的拉普拉斯变换值
-    double PWD_composite(double z, double fs1, double fs2, double M12, double LfD, double rmD, double reD, int nf, const QVector<double>& xwD, ModelType type);
+    template<typename T>
+    T PWD_composite(T z, T fs1, T fs2, ParamOf<T> M12, ParamOf<T> LfD, ParamOf<T> rmD, ParamOf<T> reD,
+                    int nf, const QVector<double>& xwD, ModelType type);
 
     // 数学辅助函数
-    double scaled_besseli(int v, double x);
-    double gauss15(std::function<double(double)> f, double a, double b);
-    double adaptiveGauss(std::function<double(double)> f, double a, double b, double eps, int depth, int maxDepth);
-    double stefestCoefficient(int i, int N);
-    double factorial(int n);
+    // 同时计算 K0、K1 (不缩放) 与 I0、I1 (乘以 exp(-x) 缩放)
+    static void besselKI(double x, double& k0, double& k1, double& i0s, double& i1s);
+    static void besselKI(std::complex<double> x, std::complex<double>& k0, std::complex<double>& k1,
+                         std::complex<double>& i0s, std::complex<double>& i1s);
+    // 积分核只需 K0 与缩放 I0 (批量计算积分节点)
+    static void besselK0I0Batch(const double* x, int n, double* k0, double* i0s);
+    static void besselK0I0Batch(const std::complex<double>* x, int n, std::complex<double>* k0, std::complex<double>* i0s);
+    // 对偶数自变量：函数值同上，偏导按 Bessel 函数导数公式传播
+    template<typename T, int N>
+    static void besselKI(const Dual<T, N>& x, Dual<T, N>& k0, Dual<T, N>& k1, Dual<T, N>& i0s, Dual<T, N>& i1s);
+    template<typename T, int N>
+    static void besselK0I0Batch(const Dual<T, N>* x, int n, Dual<T, N>* k0, Dual<T, N>* i0s);
+
+    // 求解裂缝流量方程组 A * y = 1 并返回 sum(y)；N 为编译期裂缝条数 (Eigen::Dynamic 表示运行期大小)
+    template<int N, typename T, typename Influence>
+    static T fractureFluxSum(int nf, const QVector<double>& xwD, bool isUniform, double step, const Influence& influence);
+
+    // 对偶数版本：函数值与 fractureFluxSum 相同，偏导由 A0 * dy = -dA * y0 求得 (与函数值共用系数矩阵)
+    template<typename D, typename Influence>
+    static D fractureFluxSumDual(int nf, const QVector<double>& xwD, bool isUniform, double step, const Influence& influence);
+
+    // 对称 Toeplitz 方程组求解 (Levinson 递推)，失败时返回 false；VectorT 为 Eigen 列向量
+    template<typename VectorT>
+    static bool solveSymmetricToeplitz(const VectorT& col, const VectorT& b, VectorT& x);
 
 private:
-    ModelType m_type;       // 当前模型类型
-    bool m_highPrecision;   // 高精度计算标志
+    ModelType m_type;           // 当前模型类型 (构造后不变)
+    SolverSettings m_settings;  // 默认求解配置 (未显式传入上下文时使用)
+    mutable QMutex m_settingsMutex;
+
+    QList<LaplaceCacheEntry> m_laplaceCache;   // 最近使用的在前
+    QMutex m_cacheMutex;
+    static const int kLaplaceCacheSize = 16;
+
+    QList<CurveCacheEntry> m_curveCache;       // 最近使用的在前，与拉普拉斯缓存共用互斥锁
+    static const int kCurveCacheSize = 8;
 };
 
 #endif // MODELSOLVER01_06_H
@@ -0,0 +1,218 @@
+/*
+ * populationoptimizer.cpp
+ * 文件作用: 基于种群的无导数优化器实现 (差分进化、CMA-ES)
+ * 功能描述:
+ * 1. 初始种群与 GlobalOptimizer 共用拉丁超立方采样，第 0 个个体为调用者给出的初始点。
+ * 2. 差分进化每代先生成全部试验个体再一次批量计算，逐个与父代比较，不小于父代时被替换。
+ * 3. CMA-ES 的参数取 Hansen 推荐的默认值；维数很小，每代对协方差矩阵做一次完整的特征分解。
+ *    截断到搜索框后的个体同时用于计算与分布更新，保证更新所用的点就是实际计算的点。
+ * 4. 计算失败 (+inf) 的个体在选择中排在最后，不会被选为最优。
+ */
+
+#include "populationoptimizer.h"
+#include "globaloptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+int PopulationOptimizer::defaultPopulationSize(Method method, int dimension)
+{
+    int n = std::max(dimension, 1);
+    if (method == CmaEs) return std::max(12, 4 + int(3.0 * std::log(double(n))));
+    return std::min(60, std::max(20, 10 * n));
+}
+
+bool PopulationOptimizer::evaluate(const BatchObjective& objective, const Matrix& population, Vector& sse)
+{
+    sse.resize(population.rows());
+    if (!objective(population, sse)) return false;
+    m_stats.evaluations += int(population.rows());
+    for (int i = 0; i < sse.size(); ++i) {
+        if (!std::isfinite(sse(i))) sse(i) = std::numeric_limits<double>::infinity();
+    }
+    return true;
+}
+
+PopulationOptimizer::StopReason PopulationOptimizer::minimize(const BatchObjective& objective, Vector& x,
+                                                              const Vector& lower, const Vector& upper,
+                                                              const GenerationCallback& callback)
+{
+    m_stats = Statistics();
+    if (x.size() == 0 || lower.size() != x.size() || upper.size() != x.size() || !objective)
+        return m_stats.stopReason = InvalidInput;
+    for (int d = 0; d < x.size(); ++d) {
+        if (!std::isfinite(lower(d)) || !std::isfinite(upper(d)) || !(upper(d) > lower(d)))
+            return m_stats.stopReason = InvalidInput;
+    }
+
+    if (m_options.method == CmaEs) m_stats.stopReason = runCmaEs(objective, x, lower, upper, callback);
+    else m_stats.stopReason = runDifferentialEvolution(objective, x, lower, upper, callback);
+    return m_stats.stopReason;
+}
+
+PopulationOptimizer::StopReason PopulationOptimizer::runDifferentialEvolution(const BatchObjective& objective, Vector& x,
+                                                                              const Vector& lower, const Vector& upper,
+                                                                              const GenerationCallback& callback)
+{
+    const int n = int(x.size());
+    const int np = std::max(4, m_options.populationSize > 0 ? m_options.populationSize : defaultPopulationSize(DifferentialEvolution, n));
+    std::mt19937 rng(m_options.seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::uniform_int_distribution<int> pickMember(0, np - 1);
+    std::uniform_int_distribution<int> pickDimension(0, n - 1);
+
+    // 1. 初始种群
+    Matrix population(np, n);
+    population.row(0) = x.cwiseMax(lower).cwiseMin(upper).transpose();
+    population.bottomRows(np - 1) = GlobalOptimizer::latinHypercube(np - 1, lower, upper, m_options.seed);
+    Vector fitness;
+    if (!evaluate(objective, population, fitness)) return Cancelled;
+    m_stats.initialSse = fitness(0);
+
+    int best = 0;
+    fitness.minCoeff(&best);
+    Matrix trials(np, n);
+    Vector trialFitness;
+
+    for (int gen = 0;; ++gen) {
+        m_stats.generations = gen;
+        m_stats.bestSse = fitness(best);
+        x = population.row(best).transpose();
+        if (callback && !callback(gen, x, fitness(best))) return Cancelled;
+        if (fitness(best) < m_options.targetSse) return TargetReached;
+        if (gen >= m_options.maxGenerations) return MaxGenerations;
+
+        double worst = fitness.maxCoeff();
+        if (std::isfinite(worst) && worst - fitness(best) <= m_options.tolerance * std::max(std::abs(fitness(best)), 1e-300))
+            return Stagnated;
+
+        // 2. 变异与交叉 (DE/rand/1/bin)
+        for (int i = 0; i < np; ++i) {
+            int r1, r2, r3;
+            do { r1 = pickMember(rng); } while (r1 == i);
+            do { r2 = pickMember(rng); } while (r2 == i || r2 == r1);
+            do { r3 = pickMember(rng); } while (r3 == i || r3 == r1 || r3 == r2);
+            int jRand = pickDimension(rng);
+            for (int j = 0; j < n; ++j) {
+                if (j == jRand || uniform(rng) < m_options.crossoverRate) {
+                    double v = population(r1, j) + m_options.differentialWeight * (population(r2, j) - population(r3, j));
+                    trials(i, j) = std::min(std::max(v, lower(j)), upper(j));
+                } else {
+                    trials(i, j) = population(i, j);
+                }
+            }
+        }
+
+        // 3. 一次批量计算本代全部试验个体，再逐个选择
+        if (!evaluate(objective, trials, trialFitness)) return Cancelled;
+        for (int i = 0; i < np; ++i) {
+            if (trialFitness(i) <= fitness(i)) {
+                population.row(i) = trials.row(i);
+                fitness(i) = trialFitness(i);
+                if (fitness(i) < fitness(best)) best = i;
+            }
+        }
+    }
+}
+
+PopulationOptimizer::StopReason PopulationOptimizer::runCmaEs(const BatchObjective& objective, Vector& x,
+                                                              const Vector& lower, const Vector& upper,
+                                                              const GenerationCallback& callback)
+{
+    const int n = int(x.size());
+    const int lambda = std::max(4, m_options.populationSize > 0 ? m_options.populationSize : defaultPopulationSize(CmaEs, n));
+    const int mu = lambda / 2;
+    std::mt19937 rng(m_options.seed);
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    // 1. 策略参数 (归一化坐标 y = (x - lower) / width，y 在 [0, 1] 内)
+    Vector width = upper - lower;
+    Vector weights(mu);
+    for (int i = 0; i < mu; ++i) weights(i) = std::log(mu + 0.5) - std::log(i + 1.0);
+    weights /= weights.sum();
+    const double mueff = 1.0 / weights.squaredNorm();
+    const double cc = (4.0 + mueff / n) / (n + 4.0 + 2.0 * mueff / n);
+    const double cs = (mueff + 2.0) / (n + mueff + 5.0);
+    const double c1 = 2.0 / ((n + 1.3) * (n + 1.3) + mueff);
+    const double cmu = std::min(1.0 - c1, 2.0 * (mueff - 2.0 + 1.0 / mueff) / ((n + 2.0) * (n + 2.0) + mueff));
+    const double damps = 1.0 + 2.0 * std::max(0.0, std::sqrt((mueff - 1.0) / (n + 1.0)) - 1.0) + cs;
+    const double chiN = std::sqrt(double(n)) * (1.0 - 1.0 / (4.0 * n) + 1.0 / (21.0 * n * n));
+
+    Vector mean = ((x.cwiseMax(lower).cwiseMin(upper) - lower).array() / width.array()).matrix();
+    double sigma = m_options.sigma0;
+    Matrix C = Matrix::Identity(n, n);
+    Matrix B = Matrix::Identity(n, n);
+    Vector D = Vector::Ones(n);
+    Matrix invSqrtC = Matrix::Identity(n, n);
+    Vector pc = Vector::Zero(n);
+    Vector ps = Vector::Zero(n);
+
+    Matrix y(lambda, n);
+    Matrix population(lambda, n);
+    Vector fitness;
+    Vector bestX = x;
+    double bestSse = std::numeric_limits<double>::infinity();
+    std::vector<int> order(lambda);
+    Vector z(n);
+
+    for (int gen = 0;; ++gen) {
+        // 2. 采样 (第一代的最后一个个体为初始点)，截断到搜索框后批量计算
+        for (int k = 0; k < lambda; ++k) {
+            for (int j = 0; j < n; ++j) z(j) = normal(rng);
+            Vector yk = (gen == 0 && k == lambda - 1) ? mean : Vector(mean + sigma * (B * D.asDiagonal() * z));
+            y.row(k) = yk.cwiseMax(0.0).cwiseMin(1.0).transpose();
+            population.row(k) = (lower.array() + y.row(k).transpose().array() * width.array()).transpose();
+        }
+        if (!evaluate(objective, population, fitness)) return Cancelled;
+        if (gen == 0) m_stats.initialSse = fitness(lambda - 1);
+
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return fitness(a) < fitness(b); });
+        if (fitness(order[0]) < bestSse) {
+            bestSse = fitness(order[0]);
+            bestX = population.row(order[0]).transpose();
+        }
+
+        m_stats.generations = gen + 1;
+        m_stats.bestSse = bestSse;
+        x = bestX;
+        if (callback && !callback(gen + 1, x, bestSse)) return Cancelled;
+        if (bestSse < m_options.targetSse) return TargetReached;
+        if (gen + 1 >= m_options.maxGenerations) return MaxGenerations;
+
+        // 3. 均值与进化路径
+        Vector oldMean = mean;
+        mean.setZero();
+        for (int i = 0; i < mu; ++i) mean += weights(i) * y.row(order[i]).transpose();
+        Vector shift = (mean - oldMean) / sigma;
+
+        ps = (1.0 - cs) * ps + std::sqrt(cs * (2.0 - cs) * mueff) * (invSqrtC * shift);
+        double psNorm = ps.norm();
+        bool hsig = psNorm / std::sqrt(1.0 - std::pow(1.0 - cs, 2.0 * (gen + 1))) / chiN < 1.4 + 2.0 / (n + 1.0);
+        pc = (1.0 - cc) * pc + (hsig ? std::sqrt(cc * (2.0 - cc) * mueff) : 0.0) * shift;
+
+        // 4. 协方差矩阵 (秩一 + 秩 mu) 与步长
+        Matrix artmp(n, mu);
+        for (int i = 0; i < mu; ++i) artmp.col(i) = (y.row(order[i]).transpose() - oldMean) / sigma;
+        C = (1.0 - c1 - cmu) * C
+            + c1 * (pc * pc.transpose() + (hsig ? 0.0 : cc * (2.0 - cc)) * C)
+            + cmu * artmp * weights.asDiagonal() * artmp.transpose();
+        sigma *= std::exp((cs / damps) * (psNorm / chiN - 1.0));
+
+        Eigen::SelfAdjointEigenSolver<Matrix> eig(0.5 * (C + C.transpose()));
+        B = eig.eigenvectors();
+        D = eig.eigenvalues().cwiseMax(1e-20).cwiseSqrt();
+        invSqrtC = B * D.cwiseInverse().asDiagonal() * B.transpose();
+
+        // 5. 停滞判定：分布在所有方向上都已收缩
+        if (sigma * D.maxCoeff() < m_options.tolerance) return Stagnated;
+        double spread = fitness(order[lambda - 1]) - fitness(order[0]);
+        if (std::isfinite(spread) && spread <= m_options.tolerance * std::max(std::abs(fitness(order[0])), 1e-300)
+            && sigma * D.maxCoeff() < 1e-3)
+            return Stagnated;
+    }
+}
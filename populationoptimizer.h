@@ -0,0 +1,90 @@
+/*
+ * populationoptimizer.h
+ * 文件作用: 基于种群的无导数优化器头文件 (差分进化、CMA-ES)
+ * 功能描述:
+ * 1. 只需要残差平方和，不需要雅可比矩阵，适合导数噪声较大、差分雅可比不可靠的拟合。
+ * 2. 每一代的全部个体一次交给调用者批量计算 (调用者通过求解器的批量接口并行)，个体之间没有先后依赖。
+ * 3. 差分进化采用 DE/rand/1/bin；CMA-ES 采用 (mu/mu_w, lambda) 加权重组、累积步长控制与秩一/秩 mu 协方差更新。
+ * 4. 迭代变量限制在调用者给出的搜索框内：越界的个体截断到边界后再计算。
+ *    CMA-ES 在以搜索框宽度归一化的坐标中运行，初始步长为框宽的 sigma0 倍。
+ * 5. 调用者给出的初始点作为第一代的一个个体，其余个体按拉丁超立方分布 (CMA-ES 以初始点为均值)。
+ */
+
+#ifndef POPULATIONOPTIMIZER_H
+#define POPULATIONOPTIMIZER_H
+
+#include <Eigen/Dense>
+#include <functional>
+
+class PopulationOptimizer
+{
+public:
+    using Vector = Eigen::VectorXd;
+    using Matrix = Eigen::MatrixXd;
+
+    // 批量目标函数: population 每行一个个体，sse(i) 为第 i 个体的残差平方和 (计算失败时为 +inf)；返回 false 表示被取消
+    using BatchObjective = std::function<bool(const Matrix& population, Vector& sse)>;
+    // 每代结束后调用：返回 false 时停止
+    using GenerationCallback = std::function<bool(int generation, const Vector& bestX, double bestSse)>;
+
+    enum Method {
+        DifferentialEvolution,
+        CmaEs
+    };
+
+    enum StopReason {
+        TargetReached,      // 残差平方和达到目标
+        MaxGenerations,     // 达到最大代数
+        Stagnated,          // 种群已收缩 (目标值或步长不再变化)
+        Cancelled,          // 批量计算或回调要求停止
+        InvalidInput
+    };
+
+    struct Options {
+        Method method = DifferentialEvolution;
+        int populationSize = 0;         // 0 表示按维数自动选择
+        int maxGenerations = 100;
+        double targetSse = 0.0;         // 最优个体低于此值时停止
+        double tolerance = 1e-8;        // 停滞判定的相对容差
+        unsigned int seed = 20250519u;
+        double differentialWeight = 0.7;    // DE 的缩放因子 F
+        double crossoverRate = 0.9;         // DE 的交叉概率 CR
+        double sigma0 = 0.3;                // CMA-ES 初始步长 (相对搜索框宽度)
+    };
+
+    struct Statistics {
+        int generations = 0;
+        int evaluations = 0;            // 个体计算总数
+        double initialSse = 0.0;        // 初始点的残差平方和
+        double bestSse = 0.0;
+        StopReason stopReason = InvalidInput;
+    };
+
+    PopulationOptimizer() = default;
+    explicit PopulationOptimizer(const Options& options) : m_options(options) {}
+
+    void setOptions(const Options& options) { m_options = options; }
+    const Options& options() const { return m_options; }
+
+    // 在 [lower, upper] 内最小化，x 传入初始点，返回时为最优个体
+    StopReason minimize(const BatchObjective& objective, Vector& x, const Vector& lower, const Vector& upper,
+                        const GenerationCallback& callback = GenerationCallback());
+
+    const Statistics& statistics() const { return m_stats; }
+
+    // 自动选择的种群规模
+    static int defaultPopulationSize(Method method, int dimension);
+
+private:
+    StopReason runDifferentialEvolution(const BatchObjective& objective, Vector& x, const Vector& lower, const Vector& upper,
+                                        const GenerationCallback& callback);
+    StopReason runCmaEs(const BatchObjective& objective, Vector& x, const Vector& lower, const Vector& upper,
+                        const GenerationCallback& callback);
+    // 批量计算并累计计数
+    bool evaluate(const BatchObjective& objective, const Matrix& population, Vector& sse);
+
+    Options m_options;
+    Statistics m_stats;
+};
+
+#endif // POPULATIONOPTIMIZER_H
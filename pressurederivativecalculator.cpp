@@ -210,11 +210,39 @@ PressureDerivativeResult PressureDerivativeCalculator::calculatePressureDerivati
     return result;
 }
 
-// 静态方法实现：Bourdet 导数核心算法
+// 静态方法实现：Bourdet 导数 (双对数图使用，取绝对值)
 QVector<double> PressureDerivativeCalculator::calculateBourdetDerivative(
     const QVector<double>& timeData,
     const QVector<double>& pressureDropData,
     double lSpacing)
+{
+    QVector<double> derivativeData = signedBourdetDerivative(timeData, pressureDropData, lSpacing);
+    // 导数结果取绝对值（双对数图要求正值）
+    for (double& v : derivativeData) v = std::abs(v);
+    return derivativeData;
+}
+
+// 静态方法实现：Bourdet 导数对参数的偏导
+// 取绝对值前的差分格式对压降是线性的，因此 d|B(p)|/dθ = sign(B(p)) * B(dp/dθ)
+QVector<double> PressureDerivativeCalculator::calculateBourdetDerivativeSensitivity(
+    const QVector<double>& timeData,
+    const QVector<double>& pressureDropData,
+    const QVector<double>& pressureSensitivity,
+    double lSpacing)
+{
+    QVector<double> base = signedBourdetDerivative(timeData, pressureDropData, lSpacing);
+    QVector<double> sens = signedBourdetDerivative(timeData, pressureSensitivity, lSpacing);
+    for (int i = 0; i < sens.size(); ++i) {
+        if (base[i] < 0.0) sens[i] = -sens[i];
+    }
+    return sens;
+}
+
+// 静态方法实现：Bourdet 导数核心算法 (保留符号)
+QVector<double> PressureDerivativeCalculator::signedBourdetDerivative(
+    const QVector<double>& timeData,
+    const QVector<double>& pressureDropData,
+    double lSpacing)
 {
     QVector<double> derivativeData;
     int n = timeData.size();
@@ -283,8 +311,7 @@ QVector<double> PressureDerivativeCalculator::calculateBourdetDerivative(
             }
         }
 
-        // 导数结果取绝对值（双对数图要求正值）
-        derivativeData.append(std::abs(derivative));
+        derivativeData.append(derivative);
     }
 
     return derivativeData;
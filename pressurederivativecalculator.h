@@ -119,12 +119,28 @@ public:
                                                       const QVector<double>& pressureDropData,
                                                       double lSpacing);
 
+    /**
+     * @brief Bourdet导数对模型参数的偏导 (链式法则，供拟合计算解析雅可比)
+     * @param timeData 时间数据 (t)
+     * @param pressureDropData 压降数据 (Delta P)
+     * @param pressureSensitivity 压降对该参数的偏导
+     * @param lSpacing L-Spacing参数
+     * @return calculateBourdetDerivative 结果对该参数的偏导
+     */
+    static QVector<double> calculateBourdetDerivativeSensitivity(const QVector<double>& timeData,
+                                                                 const QVector<double>& pressureDropData,
+                                                                 const QVector<double>& pressureSensitivity,
+                                                                 double lSpacing);
+
 signals:
     void progressUpdated(int progress, const QString& message);
     void calculationCompleted(const PressureDerivativeResult& result);
 
 private:
     // 内部静态辅助函数
+    static QVector<double> signedBourdetDerivative(const QVector<double>& timeData,
+                                                   const QVector<double>& pressureDropData,
+                                                   double lSpacing);
     static int findLeftPoint(const QVector<double>& timeData, int currentIndex, double lSpacing);
     static int findRightPoint(const QVector<double>& timeData, int currentIndex, double lSpacing);
     static double calculateDerivativeValue(double t1, double t2, double p1, double p2);
@@ -0,0 +1,239 @@
+/*
+ * tst_besselfunctions.cpp
+ * 文件作用: BesselFunctions 精度与一致性测试 (控制台程序，失败时返回非零)
+ * 功能描述:
+ * 1. 实数函数 i0e/i1e/k0e/k1e/k0/k1 在 [1e-12, 700] 对数等距点上与 boost::math (long double 计算) 比较相对误差。
+ * 2. 复数函数在实轴上与 boost::math 比较；在虚轴上与 J/Y 函数表示的解析式比较 (I0(iy) = J0(y)，K0(iy) = -π/2 (Y0 + i J0) 等)。
+ * 3. 任意方向复数自变量检查 Wronskian 关系 I0·K1 + I1·K0 = 1/z，并检查 k01e/i01e 与 all01e 结果一致。
+ * 4. 批量接口 (含 AVX2 路径与尾部标量路径) 与逐个调用的标量结果逐位比较。
+ */
+
+#include "besselfunctions.h"
+
+#include <boost/math/special_functions/bessel.hpp>
+
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+using Complex = BesselFunctions::Complex;
+using boost::math::cyl_bessel_i;
+using boost::math::cyl_bessel_j;
+using boost::math::cyl_bessel_k;
+using boost::math::cyl_neumann;
+
+const double kMinX = 1e-12;
+const double kMaxX = 700.0;
+const long double kPi = 3.141592653589793238462643383279502884L;
+
+int g_failures = 0;
+
+// 记录单项检查结果 (每个检查只输出首个失败点，避免刷屏)
+void report(const char* name, double maxErr, double tol, double worstX)
+{
+    bool ok = maxErr <= tol;
+    std::printf("%-6s %-28s max err %.3e (tol %.0e) at x = %.6g\n", ok ? "PASS" : "FAIL", name, maxErr, tol, worstX);
+    if (!ok) ++g_failures;
+}
+
+double relErr(double value, long double ref)
+{
+    return double(std::fabs((static_cast<long double>(value) - ref) / ref));
+}
+
+// [kMinX, kMaxX] 上的对数等距点
+std::vector<double> logGrid(int n)
+{
+    std::vector<double> x(n);
+    double a = std::log(kMinX), b = std::log(kMaxX);
+    for (int i = 0; i < n; ++i) x[i] = std::exp(a + (b - a) * i / (n - 1));
+    x.back() = kMaxX;
+    return x;
+}
+
+// ---- 实数函数与 boost 对比 ----
+void testRealAgainstBoost(const std::vector<double>& xs)
+{
+    const double tol = 5e-15;
+    struct Case {
+        const char* name;
+        double (*f)(double);
+        long double (*ref)(long double);
+    };
+    const Case cases[] = {
+        {"i0e", BesselFunctions::i0e, [](long double x) { return cyl_bessel_i(0, x) * std::exp(-x); }},
+        {"i1e", BesselFunctions::i1e, [](long double x) { return cyl_bessel_i(1, x) * std::exp(-x); }},
+        {"k0e", BesselFunctions::k0e, [](long double x) { return cyl_bessel_k(0, x) * std::exp(x); }},
+        {"k1e", BesselFunctions::k1e, [](long double x) { return cyl_bessel_k(1, x) * std::exp(x); }},
+        {"k0", BesselFunctions::k0, [](long double x) { return cyl_bessel_k(0, x); }},
+        {"k1", BesselFunctions::k1, [](long double x) { return cyl_bessel_k(1, x); }},
+    };
+    for (const Case& c : cases) {
+        double maxErr = 0.0, worstX = 0.0;
+        for (double x : xs) {
+            double err = relErr(c.f(x), c.ref(x));
+            if (err > maxErr) { maxErr = err; worstX = x; }
+        }
+        report(c.name, maxErr, tol, worstX);
+    }
+
+    // I 函数为偶/奇函数，负自变量与正自变量对称
+    double maxErr = 0.0, worstX = 0.0;
+    for (double x : xs) {
+        double err = std::max(std::fabs(BesselFunctions::i0e(-x) - BesselFunctions::i0e(x)),
+                              std::fabs(BesselFunctions::i1e(-x) + BesselFunctions::i1e(x)));
+        if (err > maxErr) { maxErr = err; worstX = x; }
+    }
+    report("i0e/i1e parity", maxErr, 0.0, worstX);
+}
+
+// ---- 复数函数 ----
+double complexRelErr(Complex value, std::complex<long double> ref, long double scale)
+{
+    std::complex<long double> v(value.real(), value.imag());
+    return double(std::abs(v - ref) / scale);
+}
+
+// 实轴: 与 boost 实数结果比较，虚部应为 0
+void testComplexRealAxis(const std::vector<double>& xs)
+{
+    const double tol = 1e-13;
+    double maxErr = 0.0, worstX = 0.0;
+    for (double x : xs) {
+        long double lx = x;
+        std::complex<long double> ref[4] = {cyl_bessel_k(0, lx) * std::exp(lx), cyl_bessel_k(1, lx) * std::exp(lx),
+                                            cyl_bessel_i(0, lx) * std::exp(-lx), cyl_bessel_i(1, lx) * std::exp(-lx)};
+        Complex v[4];
+        BesselFunctions::all01e(Complex(x, 0.0), v[0], v[1], v[2], v[3]);
+        for (int k = 0; k < 4; ++k) {
+            double err = complexRelErr(v[k], ref[k], std::abs(ref[k]));
+            if (err > maxErr) { maxErr = err; worstX = x; }
+        }
+    }
+    report("complex real axis", maxErr, tol, worstX);
+}
+
+// 虚轴 z = iy: I0 = J0，I1 = i J1，K0 = -π/2 (Y0 + i J0)，K1 = -π/2 (J1 - i Y1)
+// I 的误差以 Hankel 函数模 sqrt(J² + Y²) 为尺度 (J 的零点附近相对误差无意义)
+void testComplexImaginaryAxis(const std::vector<double>& ys)
+{
+    const double tol = 1e-13;
+    const std::complex<long double> I(0.0L, 1.0L);
+    double maxErr = 0.0, worstY = 0.0;
+    for (double y : ys) {
+        long double ly = y;
+        long double j0 = cyl_bessel_j(0, ly), j1 = cyl_bessel_j(1, ly);
+        long double y0 = cyl_neumann(0, ly), y1 = cyl_neumann(1, ly);
+        std::complex<long double> ePlus = std::exp(I * ly), eMinus = std::exp(-I * ly);
+        std::complex<long double> ref[4] = {ePlus * (-kPi / 2) * (y0 + I * j0), ePlus * (-kPi / 2) * (j1 - I * y1),
+                                            eMinus * j0, eMinus * I * j1};
+        long double scale0 = std::hypot(j0, y0), scale1 = std::hypot(j1, y1);
+        long double scale[4] = {kPi / 2 * scale0, kPi / 2 * scale1, scale0, scale1};
+        Complex v[4];
+        BesselFunctions::all01e(Complex(0.0, y), v[0], v[1], v[2], v[3]);
+        for (int k = 0; k < 4; ++k) {
+            double err = complexRelErr(v[k], ref[k], scale[k]);
+            if (err > maxErr) { maxErr = err; worstY = y; }
+        }
+    }
+    report("complex imaginary axis", maxErr, tol, worstY);
+}
+
+// 任意方向: Wronskian 关系 i0e·k1e + i1e·k0e = 1/z；k01e/i01e 与 all01e 一致
+void testComplexWronskian(const std::vector<double>& rs)
+{
+    const double tol = 1e-13;
+    const double angles[] = {0.1, 0.4, 0.7854, 1.2, 1.5, 1.5707963267948966};
+    double maxErr = 0.0, worstR = 0.0, maxDiff = 0.0, worstDiffR = 0.0;
+    for (double r : rs) {
+        for (double a : angles) {
+            Complex z = std::polar(r, a);
+            Complex k0, k1, i0, i1;
+            BesselFunctions::all01e(z, k0, k1, i0, i1);
+            double err = std::abs((i0 * k1 + i1 * k0) * z - 1.0);
+            if (err > maxErr) { maxErr = err; worstR = r; }
+
+            Complex kk0, kk1, ii0, ii1;
+            BesselFunctions::k01e(z, kk0, kk1);
+            BesselFunctions::i01e(z, ii0, ii1);
+            double diff = std::max(std::max(std::abs(kk0 - k0) / std::abs(k0), std::abs(kk1 - k1) / std::abs(k1)),
+                                   std::max(std::abs(ii0 - i0) / std::abs(i0), std::abs(ii1 - i1) / std::abs(i1)));
+            if (diff > maxDiff) { maxDiff = diff; worstDiffR = r; }
+        }
+    }
+    report("complex Wronskian", maxErr, tol, worstR);
+    report("k01e/i01e vs all01e", maxDiff, 1e-15, worstDiffR);
+}
+
+// ---- 批量接口与标量逐位一致 ----
+void testBatchMatchesScalar(const std::vector<double>& xs)
+{
+    // 奇数长度覆盖 4 路向量之后的尾部；插入 x <= 2 的点覆盖向量路径中的小自变量分支
+    std::vector<double> x = xs;
+    x.push_back(0.5);
+    x.push_back(2.0);
+    x.push_back(2.0000001);
+    if (x.size() % 2 == 0) x.push_back(3.0);
+    const int n = int(x.size());
+
+    struct Case {
+        const char* name;
+        void (*batch)(const double*, double*, int);
+        double (*scalar)(double);
+    };
+    const Case cases[] = {
+        {"i0eBatch", BesselFunctions::i0eBatch, BesselFunctions::i0e},
+        {"i1eBatch", BesselFunctions::i1eBatch, BesselFunctions::i1e},
+        {"k0eBatch", BesselFunctions::k0eBatch, BesselFunctions::k0e},
+        {"k1eBatch", BesselFunctions::k1eBatch, BesselFunctions::k1e},
+    };
+    std::vector<double> out(n), out2(n);
+    for (const Case& c : cases) {
+        c.batch(x.data(), out.data(), n);
+        double maxErr = 0.0, worstX = 0.0;
+        for (int i = 0; i < n; ++i) {
+            double err = relErr(out[i], c.scalar(x[i]));
+            if (err > maxErr) { maxErr = err; worstX = x[i]; }
+        }
+        report(c.name, maxErr, 0.0, worstX);
+    }
+
+    BesselFunctions::k0i0eBatch(x.data(), out.data(), out2.data(), n);
+    double maxErr = 0.0, worstX = 0.0;
+    for (int i = 0; i < n; ++i) {
+        double err = std::max(relErr(out[i], BesselFunctions::k0(x[i])), relErr(out2[i], BesselFunctions::i0e(x[i])));
+        if (err > maxErr) { maxErr = err; worstX = x[i]; }
+    }
+    report("k0i0eBatch", maxErr, 0.0, worstX);
+
+    // I 函数批量接口支持负自变量
+    std::vector<double> neg(n);
+    for (int i = 0; i < n; ++i) neg[i] = -x[i];
+    maxErr = 0.0;
+    worstX = 0.0;
+    BesselFunctions::i0eBatch(neg.data(), out.data(), n);
+    BesselFunctions::i1eBatch(neg.data(), out2.data(), n);
+    for (int i = 0; i < n; ++i) {
+        double err = std::max(relErr(out[i], BesselFunctions::i0e(neg[i])), relErr(out2[i], BesselFunctions::i1e(neg[i])));
+        if (err > maxErr) { maxErr = err; worstX = neg[i]; }
+    }
+    report("i0eBatch/i1eBatch negative", maxErr, 0.0, worstX);
+}
+
+} // namespace
+
+int main()
+{
+    const std::vector<double> xs = logGrid(2001);
+    testRealAgainstBoost(xs);
+    testComplexRealAxis(xs);
+    testComplexImaginaryAxis(xs);
+    testComplexWronskian(logGrid(301));
+    testBatchMatchesScalar(xs);
+
+    std::printf("%s: %d failure(s)\n", g_failures ? "FAILED" : "OK", g_failures);
+    return g_failures ? 1 : 0;
+}
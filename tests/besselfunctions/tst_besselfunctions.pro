@@ -0,0 +1,27 @@
+# ----------------------------------------------------
+# Project: tst_besselfunctions
+# Description: BesselFunctions 精度测试 (与 boost::math 对比，批量接口与标量逐位比较)
+# 运行: qmake && make && ./tst_besselfunctions，全部通过时返回 0
+# ----------------------------------------------------
+
+TEMPLATE = app
+TARGET = tst_besselfunctions
+CONFIG += console c++17
+CONFIG -= qt app_bundle
+
+# 与主工程相同的优化选项 (批量接口的 AVX2 路径运行时分派，不需要 -mavx2)
+QMAKE_CXXFLAGS += -O3
+QMAKE_CXXFLAGS_RELEASE -= -O2
+QMAKE_CXXFLAGS_RELEASE += -O3
+
+INCLUDEPATH += ../..
+
+# Boost 库 (参考值)
+INCLUDEPATH += D:/08YYYXXX/boost_1_89_0
+
+SOURCES += \
+    ../../besselfunctions.cpp \
+    tst_besselfunctions.cpp
+
+HEADERS += \
+    ../../besselfunctions.h
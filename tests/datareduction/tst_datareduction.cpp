@@ -0,0 +1,210 @@
+/*
+ * tst_datareduction.cpp
+ * 文件作用: DataReduction 抽稀回归测试 (控制台程序，失败时返回非零)
+ * 功能描述:
+ * 1. 重复的时间戳不开始新的流动段，合并在同一个时间箱内。
+ * 2. 时间减小处开始新的流动段，时间箱不跨越流动段边界。
+ * 3. 压差、导数权重的平方平均为 1；噪声较大的时间箱权重较小。
+ * 4. 原始导数为空时结果的 derivative、weightD 均为空。
+ * 5. 带噪声与野值的已知斜坡：均值法、中位数法的代表值与箱内样本直接计算的结果一致，中位数法不受野值影响。
+ */
+
+#include "datareduction.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+int g_failures = 0;
+
+void check(const char* name, bool ok, const char* detailFormat = "", double detail = 0.0)
+{
+    std::printf("%-6s %-58s ", ok ? "PASS" : "FAIL", name);
+    std::printf(detailFormat, detail);
+    std::printf("\n");
+    if (!ok) ++g_failures;
+}
+
+// 可重复的伪随机噪声，取值 [-1, 1]
+double noise(int i)
+{
+    double v = std::sin(12.9898 * (i + 1)) * 43758.5453;
+    return 2.0 * (v - std::floor(v)) - 1.0;
+}
+
+// [t0, t1] 上 n 个对数均匀时间
+QVector<double> logTimes(double t0, double t1, int n)
+{
+    QVector<double> t(n);
+    for (int i = 0; i < n; ++i) t[i] = t0 * std::pow(t1 / t0, double(i) / (n - 1));
+    return t;
+}
+
+double meanSquare(const QVector<double>& w)
+{
+    double sum = 0.0;
+    for (double v : w) sum += v * v;
+    return w.isEmpty() ? 0.0 : sum / w.size();
+}
+
+int totalCount(const DataReduction::Result& r)
+{
+    int sum = 0;
+    for (int c : r.count) sum += c;
+    return sum;
+}
+
+void testDuplicateTimestamps()
+{
+    // 采样分辨率不足时的重复时间戳：bin 0 = [1, 10^(1/20))，bin 6 含 2.0
+    QVector<double> t = {1.0, 1.0, 1.0, 1.05, 1.05, 2.0, 2.0, 2.0, 5.0};
+    QVector<double> p = {1.0, 1.1, 0.9, 1.2, 1.0, 2.0, 2.1, 1.9, 5.0};
+
+    QVector<int> starts = DataReduction::flowPeriodStarts(t);
+    check("duplicates: one flow period", starts.size() == 1 && starts[0] == 0, "periods = %g", starts.size());
+
+    DataReduction::Options options;
+    DataReduction::Result r = DataReduction::reduce(t, p, QVector<double>(), options);
+    bool counts = (r.count.size() == 3 && r.count[0] == 5 && r.count[1] == 3 && r.count[2] == 1);
+    check("duplicates: repeated timestamps merged into one bin each", counts && r.flowPeriods == 1, "bins = %g", r.count.size());
+    bool increasing = true;
+    for (int i = 1; i < r.time.size(); ++i) increasing = increasing && r.time[i] > r.time[i - 1];
+    check("duplicates: reduced times strictly increasing", increasing);
+}
+
+void testFlowPeriodReset()
+{
+    // 两个流动段，第二段时间从头开始
+    QVector<double> t1 = logTimes(0.01, 100.0, 300);
+    QVector<double> t2 = logTimes(0.01, 50.0, 200);
+    QVector<double> t = t1, p;
+    t << t2;
+    for (int i = 0; i < t.size(); ++i) p.append(10.0 * std::pow(t[i], 0.5) * (1.0 + 0.01 * noise(i)));
+
+    QVector<int> starts = DataReduction::flowPeriodStarts(t);
+    check("time reset: two flow periods found", starts.size() == 2 && starts[1] == t1.size(), "second start = %g", starts.value(1, -1));
+
+    DataReduction::Options options;
+    options.pointsPerCycle = 10;
+    DataReduction::Result r = DataReduction::reduce(t, p, QVector<double>(), options);
+    check("time reset: result reports two flow periods", r.flowPeriods == 2);
+    check("time reset: every sample is in exactly one bin", totalCount(r) == t.size(), "total = %g", totalCount(r));
+
+    // 时间减小处恰好是第一段样本数的累计位置，即没有时间箱跨越边界
+    int drops = 0, countBefore = 0, cumulative = 0;
+    for (int i = 0; i < r.time.size(); ++i) {
+        if (i > 0 && r.time[i] < r.time[i - 1]) {
+            ++drops;
+            countBefore = cumulative;
+        }
+        cumulative += r.count[i];
+    }
+    check("time reset: no bin spans the period boundary", drops == 1 && countBefore == t1.size(), "samples before reset = %g", countBefore);
+}
+
+void testWeights()
+{
+    // 前半段噪声 1%，后半段 8%
+    QVector<double> t = logTimes(0.01, 1000.0, 800);
+    QVector<double> p, d;
+    for (int i = 0; i < t.size(); ++i) {
+        double level = (i < t.size() / 2) ? 0.01 : 0.08;
+        p.append(5.0 * std::pow(t[i], 0.3) * (1.0 + level * noise(i)));
+        d.append(1.5 * std::pow(t[i], 0.3) * (1.0 + level * noise(i + 5000)));
+    }
+    DataReduction::Options options;
+    DataReduction::Result r = DataReduction::reduce(t, p, d, options);
+    check("weights: pressure weights have mean square 1", std::fabs(meanSquare(r.weightP) - 1.0) < 1e-12, "mean square = %.15g", meanSquare(r.weightP));
+    check("weights: derivative weights have mean square 1", std::fabs(meanSquare(r.weightD) - 1.0) < 1e-12, "mean square = %.15g", meanSquare(r.weightD));
+    check("weights: one weight per reduced point", r.weightP.size() == r.time.size() && r.weightD.size() == r.time.size());
+
+    double quiet = 0.0, noisy = 0.0;
+    int nQuiet = 0, nNoisy = 0;
+    for (int i = 0; i < r.time.size(); ++i) {
+        if (r.count[i] < 5) continue;
+        if (r.time[i] < 0.5) { quiet += r.weightP[i]; ++nQuiet; }
+        if (r.time[i] > 20.0) { noisy += r.weightP[i]; ++nNoisy; }
+    }
+    quiet /= std::max(1, nQuiet);
+    noisy /= std::max(1, nNoisy);
+    check("weights: noisier bins get smaller weights", nQuiet > 0 && nNoisy > 0 && noisy < 0.5 * quiet, "noisy / quiet = %.3f", noisy / quiet);
+}
+
+void testMissingDerivative()
+{
+    QVector<double> t = logTimes(0.1, 100.0, 120);
+    QVector<double> p;
+    for (double v : t) p.append(std::log(v) + 5.0);
+    DataReduction::Options options;
+    DataReduction::Result r = DataReduction::reduce(t, p, QVector<double>(), options);
+    check("no derivative: derivative and weightD empty", r.derivative.isEmpty() && r.weightD.isEmpty());
+    check("no derivative: pressure still reduced", !r.time.isEmpty() && r.deltaP.size() == r.time.size() && r.weightP.size() == r.time.size(),
+          "points = %g", r.time.size());
+}
+
+void testMedianVersusMean()
+{
+    // 斜坡 deltaP = 2 t，5% 噪声，每 7 个样本一个 3 倍野值
+    QVector<double> t = logTimes(1.0, 1000.0, 600);
+    QVector<double> p;
+    for (int i = 0; i < t.size(); ++i) {
+        double v = 2.0 * t[i] * (1.0 + 0.05 * noise(i));
+        if (i % 7 == 3) v *= 3.0;
+        p.append(v);
+    }
+
+    for (int m = 0; m < 2; ++m) {
+        DataReduction::Options options;
+        options.pointsPerCycle = 10;
+        options.method = (m == 0) ? DataReduction::Median : DataReduction::Mean;
+        DataReduction::Result r = DataReduction::reduce(t, p, QVector<double>(), options);
+
+        // 按合并个数取回各箱样本，直接计算代表值比较
+        double maxDiff = 0.0, maxRampErr = 0.0;
+        int first = 0;
+        for (int b = 0; b < r.time.size(); ++b) {
+            QVector<double> bt = t.mid(first, r.count[b]);
+            QVector<double> bp = p.mid(first, r.count[b]);
+            first += r.count[b];
+            double expectedP, expectedT;
+            if (options.method == DataReduction::Mean) {
+                double sumP = 0.0, sumLogT = 0.0;
+                for (int k = 0; k < bp.size(); ++k) { sumP += bp[k]; sumLogT += std::log(bt[k]); }
+                expectedP = sumP / bp.size();
+                expectedT = bp.size() > 1 ? std::exp(sumLogT / bp.size()) : bt[0];
+            } else {
+                std::sort(bp.begin(), bp.end());
+                std::sort(bt.begin(), bt.end());
+                int n = bp.size();
+                expectedP = (n % 2) ? bp[n / 2] : 0.5 * (bp[n / 2 - 1] + bp[n / 2]);
+                expectedT = (n % 2) ? bt[n / 2] : 0.5 * (bt[n / 2 - 1] + bt[n / 2]);
+            }
+            maxDiff = std::max(maxDiff, std::fabs(r.deltaP[b] - expectedP) / expectedP);
+            maxDiff = std::max(maxDiff, std::fabs(r.time[b] - expectedT) / expectedT);
+            if (r.count[b] >= 7) maxRampErr = std::max(maxRampErr, std::fabs(r.deltaP[b] / (2.0 * r.time[b]) - 1.0));
+        }
+        if (options.method == DataReduction::Median) {
+            check("median: matches the direct median of each bin", maxDiff < 1e-14, "max rel diff = %.2e", maxDiff);
+            check("median: robust to outliers on the ramp", maxRampErr < 0.1, "max ramp error = %.3f", maxRampErr);
+        } else {
+            check("mean: matches the direct mean of each bin", maxDiff < 1e-13, "max rel diff = %.2e", maxDiff);
+            check("mean: pulled off the ramp by outliers", maxRampErr > 0.2, "max ramp error = %.3f", maxRampErr);
+        }
+    }
+}
+
+} // namespace
+
+int main()
+{
+    testDuplicateTimestamps();
+    testFlowPeriodReset();
+    testWeights();
+    testMissingDerivative();
+    testMedianVersusMean();
+
+    std::printf("%s: %d failure(s)\n", g_failures ? "FAILED" : "OK", g_failures);
+    return g_failures ? 1 : 0;
+}
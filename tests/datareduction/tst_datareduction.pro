@@ -0,0 +1,27 @@
+# ----------------------------------------------------
+# Project: tst_datareduction
+# Description: DataReduction 抽稀回归测试 (重复时间戳、流动段边界、权重归一化、无导数、中位数/均值)
+# 运行: qmake && make && ./tst_datareduction，全部通过时返回 0
+# ----------------------------------------------------
+
+TEMPLATE = app
+TARGET = tst_datareduction
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+# 只用到 QVector
+QT = core
+
+# 与主工程相同的优化选项
+QMAKE_CXXFLAGS += -O3
+QMAKE_CXXFLAGS_RELEASE -= -O2
+QMAKE_CXXFLAGS_RELEASE += -O3
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    ../../datareduction.cpp \
+    tst_datareduction.cpp
+
+HEADERS += \
+    ../../datareduction.h
@@ -0,0 +1,368 @@
+/*
+ * tst_lmoptimizer.cpp
+ * 文件作用: LMOptimizer 回归测试 (控制台程序，失败时返回非零)
+ * 功能描述:
+ * 1. 已知极小点的指数衰减拟合 (无噪声数据) 收敛到真值，停止原因为 Converged。
+ * 2. 线性最小二乘问题上，阻尼很小时一步的 SVD 解与 Eigen QR 最小二乘解一致。
+ * 3. 上界起作用时试探点从不越界，收敛到边界上的约束极小点。
+ * 4. 雅可比矩阵秩亏 (两列相同、一列为零) 时仍给出有限的极小点，零列对应的参数保持不变。
+ * 5. Broyden 模式按间隔重新完整计算雅可比矩阵，收敛到同一极小点且雅可比计算次数更少。
+ * 6. 起点已是极小点 (残差不为零) 时步长全部被拒绝，阻尼系数超限后以 DampingLimit 停止，x 不变。
+ * 7. 残差回调返回 false 时以 Cancelled 停止，x 为最近接受的点；continueIteration 返回 false 时以 Stopped 停止。
+ * 8. Rosenbrock 问题上比较逐次试探、投机阻尼、测地加速与 Broyden：均收敛到 (1, 1)；投机阻尼只在第一个阻尼系数
+ *    被拒绝的迭代多算一轮批量试探，没有拒绝的问题上与逐次试探的迭代路径完全相同。
+ */
+
+#include "lmoptimizer.h"
+
+#include <Eigen/Dense>
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+namespace {
+
+using Vector = LMOptimizer::Vector;
+using Matrix = LMOptimizer::Matrix;
+
+int g_failures = 0;
+
+void check(const char* name, bool ok, const char* detailFormat = "", double detail = 0.0)
+{
+    std::printf("%-6s %-60s ", ok ? "PASS" : "FAIL", name);
+    std::printf(detailFormat, detail);
+    std::printf("\n");
+    if (!ok) ++g_failures;
+}
+
+// ---- 指数衰减 y = a exp(-b t) + c ----
+struct ExpDecay {
+    Vector t, y;
+    explicit ExpDecay(int n, double a, double b, double c) : t(n), y(n)
+    {
+        for (int i = 0; i < n; ++i) {
+            t(i) = 0.1 * i;
+            y(i) = a * std::exp(-b * t(i)) + c;
+        }
+    }
+    LMOptimizer::Problem problem() const
+    {
+        LMOptimizer::Problem p;
+        p.residuals = [this](const Vector& x, Vector& r) {
+            r = (x(0) * (-x(1) * t.array()).exp() + x(2)).matrix() - y;
+            return true;
+        };
+        p.jacobian = [this](const Vector& x, const Vector&, Matrix& J) {
+            Eigen::ArrayXd e = (-x(1) * t.array()).exp();
+            J.col(0) = e.matrix();
+            J.col(1) = (-x(0) * t.array() * e).matrix();
+            J.col(2).setOnes();
+            return true;
+        };
+        return p;
+    }
+};
+
+void testKnownMinimum()
+{
+    ExpDecay data(40, 3.0, 1.3, 0.5);
+    LMOptimizer::Options options;
+    options.targetMse = 1e-24;
+    LMOptimizer optimizer(options);
+    Vector x(3);
+    x << 1.0, 0.2, 0.0;
+    LMOptimizer::StopReason reason = optimizer.minimize(data.problem(), x);
+    Vector truth(3);
+    truth << 3.0, 1.3, 0.5;
+    double err = (x - truth).cwiseAbs().maxCoeff();
+    check("known minimum: converges to true parameters", err < 1e-9, "max |x - x*| = %.2e", err);
+    check("known minimum: stop reason Converged", reason == LMOptimizer::Converged, "iterations = %g", optimizer.statistics().iterations);
+    check("known minimum: final SSE below initial", optimizer.statistics().finalSse < optimizer.statistics().initialSse);
+}
+
+// ---- 线性问题 r = A x - b ----
+struct LinearProblem {
+    Matrix A;
+    Vector b;
+    LinearProblem() : A(6, 3), b(6)
+    {
+        A << 1, 2, 0.5,
+             0, 1, 3,
+             4, -1, 1,
+             2, 2, 2,
+             -1, 0, 1,
+             3, 1, -2;
+        b << 1, -2, 0.5, 3, 1, -1;
+    }
+    LMOptimizer::Problem problem() const
+    {
+        LMOptimizer::Problem p;
+        p.residuals = [this](const Vector& x, Vector& r) { r = A * x - b; return true; };
+        p.jacobian = [this](const Vector&, const Vector&, Matrix& J) { J = A; return true; };
+        p.batchResiduals = [this](const Matrix& X, Matrix& R) { R = A * X; R.colwise() -= b; return true; };
+        return p;
+    }
+};
+
+// lambda 很小时一步即为最小二乘解
+void testSvdSolveMatchesLeastSquares()
+{
+    LinearProblem linear;
+    const Matrix& A = linear.A;
+    const Vector& b = linear.b;
+    LMOptimizer::Problem p = linear.problem();
+    LMOptimizer::Options options;
+    options.maxIterations = 1;
+    options.initialLambda = 1e-14;
+    options.targetMse = 0.0;
+    LMOptimizer optimizer(options);
+    Vector x = Vector::Zero(3);
+    optimizer.minimize(p, x);
+
+    Vector reference = A.colPivHouseholderQr().solve(b);
+    double err = (x - reference).cwiseAbs().maxCoeff();
+    check("SVD step: one step equals QR least-squares solution", err < 1e-10, "max diff = %.2e", err);
+}
+
+// r = (x0 - 2, x1 + 1)，上界 x0 <= 1：约束极小点 (1, -1)
+void testBoundActive()
+{
+    double maxX0 = -std::numeric_limits<double>::infinity();
+    LMOptimizer::Problem p;
+    p.residuals = [&](const Vector& x, Vector& r) {
+        maxX0 = std::max(maxX0, x(0));
+        r.resize(2);
+        r << x(0) - 2.0, x(1) + 1.0;
+        return true;
+    };
+    p.jacobian = [](const Vector&, const Vector&, Matrix& J) { J.setIdentity(); return true; };
+    p.lower = Vector::Constant(2, -10.0);
+    p.upper = Vector::Constant(2, 10.0);
+    p.upper(0) = 1.0;
+    LMOptimizer::Options options;
+    options.targetMse = 0.0;
+    LMOptimizer optimizer(options);
+    Vector x(2);
+    x << -3.0, 5.0;
+    optimizer.minimize(p, x);
+    check("bound active: trial points never exceed the bound", maxX0 <= 1.0, "max x0 evaluated = %.17g", maxX0);
+    double err = std::max(std::fabs(x(0) - 1.0), std::fabs(x(1) + 1.0));
+    check("bound active: reaches the constrained minimum (1, -1)", err < 1e-8, "max err = %.2e", err);
+    check("bound active: SSE at the minimum is 1", std::fabs(optimizer.statistics().finalSse - 1.0) < 1e-8, "SSE = %.12g", optimizer.statistics().finalSse);
+}
+
+// r_i = x0 + x1 - y_i：雅可比两列相同；x2 不影响残差 (零列)
+void testRankDeficient()
+{
+    Vector y(5);
+    y << 1.0, 2.0, 3.0, 4.0, 5.0;
+    LMOptimizer::Problem p;
+    p.residuals = [&](const Vector& x, Vector& r) { r = Vector::Constant(5, x(0) + x(1)) - y; return true; };
+    p.jacobian = [](const Vector&, const Vector&, Matrix& J) {
+        J.col(0).setOnes();
+        J.col(1).setOnes();
+        J.col(2).setZero();
+        return true;
+    };
+    LMOptimizer::Options options;
+    options.targetMse = 0.0;
+    LMOptimizer optimizer(options);
+    Vector x(3);
+    x << 0.0, 0.0, 7.0;
+    optimizer.minimize(p, x);
+    check("rank deficient: parameters stay finite", x.allFinite());
+    check("rank deficient: x0 + x1 reaches the mean of y", std::fabs(x(0) + x(1) - 3.0) < 1e-8, "x0 + x1 = %.12g", x(0) + x(1));
+    check("rank deficient: minimum-norm split x0 = x1", std::fabs(x(0) - x(1)) < 1e-10, "x0 - x1 = %.2e", x(0) - x(1));
+    check("rank deficient: zero-column parameter unchanged", x(2) == 7.0, "x2 = %.17g", x(2));
+    check("rank deficient: SSE at the minimum is 10", std::fabs(optimizer.statistics().finalSse - 10.0) < 1e-8, "SSE = %.12g", optimizer.statistics().finalSse);
+}
+
+void testBroydenRefresh()
+{
+    ExpDecay data(40, 3.0, 1.3, 0.5);
+    LMOptimizer::Options options;
+    options.targetMse = 1e-24;
+    options.maxIterations = 200;
+    options.broydenUpdate = true;
+    options.jacobianRefresh = 4;
+    LMOptimizer optimizer(options);
+    Vector x(3);
+    x << 1.0, 0.2, 0.0;
+    optimizer.minimize(data.problem(), x);
+    const LMOptimizer::Statistics& s = optimizer.statistics();
+    Vector truth(3);
+    truth << 3.0, 1.3, 0.5;
+    double err = (x - truth).cwiseAbs().maxCoeff();
+    check("Broyden: converges to true parameters", err < 1e-9, "max |x - x*| = %.2e", err);
+    check("Broyden: rank-one updates applied", s.broydenUpdates > 0, "updates = %g", s.broydenUpdates);
+    check("Broyden: fewer Jacobians than iterations", s.jacobianEvaluations < s.iterations, "Jacobians = %g", s.jacobianEvaluations);
+    // 每 jacobianRefresh 轮至少完整计算一次
+    int minimumRefreshes = (s.iterations + options.jacobianRefresh - 1) / options.jacobianRefresh;
+    check("Broyden: full Jacobian at least every jacobianRefresh rounds", s.jacobianEvaluations >= minimumRefreshes, "Jacobians = %g", s.jacobianEvaluations);
+}
+
+// r = (x, 1)：起点 x = 0 已是极小点，SSE = 1 无法下降
+void testDampingLimit()
+{
+    LMOptimizer::Problem p;
+    p.residuals = [](const Vector& x, Vector& r) { r.resize(2); r << x(0), 1.0; return true; };
+    p.jacobian = [](const Vector&, const Vector&, Matrix& J) { J << 1.0, 0.0; return true; };
+    LMOptimizer::Options options;
+    options.targetMse = 0.0;
+    LMOptimizer optimizer(options);
+    Vector x = Vector::Zero(1);
+    LMOptimizer::StopReason reason = optimizer.minimize(p, x);
+    const LMOptimizer::Statistics& s = optimizer.statistics();
+    check("damping limit: stop reason DampingLimit", reason == LMOptimizer::DampingLimit, "iterations = %g", s.iterations);
+    check("damping limit: final lambda above maxLambda", s.finalLambda > options.maxLambda, "lambda = %.1e", s.finalLambda);
+    check("damping limit: every trial rejected, x unchanged", x(0) == 0.0 && s.rejectedSteps == s.iterations * options.maxDampingTries, "rejected = %g", s.rejectedSteps);
+}
+
+void testCancelAndStop()
+{
+    ExpDecay data(40, 3.0, 1.3, 0.5);
+    LMOptimizer::Problem p = data.problem();
+    LMOptimizer::ResidualFunction residuals = p.residuals;
+    int calls = 0;
+    p.residuals = [&](const Vector& x, Vector& r) { return ++calls <= 4 && residuals(x, r); };
+    Vector lastAccepted;
+    p.stepAccepted = [&](const Vector& x, double) { lastAccepted = x; };
+    LMOptimizer::Options options;
+    options.targetMse = 0.0;
+    LMOptimizer optimizer(options);
+    Vector x(3);
+    x << 1.0, 0.2, 0.0;
+    LMOptimizer::StopReason reason = optimizer.minimize(p, x);
+    check("cancel: stop reason Cancelled", reason == LMOptimizer::Cancelled);
+    check("cancel: x is the last accepted point", lastAccepted.size() == 3 && x == lastAccepted);
+
+    p = data.problem();
+    p.continueIteration = [](int iteration, double) { return iteration < 3; };
+    x << 1.0, 0.2, 0.0;
+    reason = optimizer.minimize(p, x);
+    check("continueIteration: stop reason Stopped after 3 iterations", reason == LMOptimizer::Stopped && optimizer.statistics().iterations == 3,
+          "iterations = %g", optimizer.statistics().iterations);
+}
+
+// ---- Rosenbrock: r = (10 (x1 - x0^2), 1 - x0)，极小点 (1, 1) ----
+LMOptimizer::Problem rosenbrock()
+{
+    auto f = [](const Vector& x, Vector& r) {
+        r.resize(2);
+        r << 10.0 * (x(1) - x(0) * x(0)), 1.0 - x(0);
+    };
+    LMOptimizer::Problem p;
+    p.residuals = [f](const Vector& x, Vector& r) { f(x, r); return true; };
+    p.batchResiduals = [f](const Matrix& X, Matrix& R) {
+        Vector r;
+        for (int k = 0; k < X.cols(); ++k) {
+            f(X.col(k), r);
+            R.col(k) = r;
+        }
+        return true;
+    };
+    p.jacobian = [](const Vector& x, const Vector&, Matrix& J) {
+        J << -20.0 * x(0), 10.0,
+             -1.0, 0.0;
+        return true;
+    };
+    return p;
+}
+
+struct ModeRun {
+    LMOptimizer::Statistics stats;
+    Vector x;
+};
+
+ModeRun runRosenbrock(bool speculative, bool geodesic, bool broyden)
+{
+    LMOptimizer::Options options;
+    options.targetMse = 1e-30;
+    options.maxIterations = 200;
+    options.speculativeDamping = speculative;
+    options.geodesicAcceleration = geodesic;
+    options.broydenUpdate = broyden;
+    LMOptimizer optimizer(options);
+    ModeRun run;
+    run.x.resize(2);
+    run.x << -1.2, 1.0;
+    optimizer.minimize(rosenbrock(), run.x);
+    run.stats = optimizer.statistics();
+    return run;
+}
+
+void testDampingModes()
+{
+    const int tries = LMOptimizer::Options().maxDampingTries;
+    const ModeRun serial = runRosenbrock(false, false, false);
+    const ModeRun speculative = runRosenbrock(true, false, false);
+    const ModeRun geodesic = runRosenbrock(false, true, false);
+    const ModeRun broyden = runRosenbrock(false, false, true);
+    const ModeRun combined = runRosenbrock(true, true, false);
+
+    const struct {
+        const char* name;
+        const ModeRun* run;
+    } runs[] = {{"Rosenbrock serial: reaches (1, 1)", &serial},
+                {"Rosenbrock speculative: reaches (1, 1)", &speculative},
+                {"Rosenbrock geodesic: reaches (1, 1)", &geodesic},
+                {"Rosenbrock Broyden: reaches (1, 1)", &broyden},
+                {"Rosenbrock speculative + geodesic: reaches (1, 1)", &combined}};
+    for (const auto& r : runs) {
+        double err = (r.run->x - Vector::Ones(2)).cwiseAbs().maxCoeff();
+        check(r.name, err < 1e-8 && r.run->stats.stopReason == LMOptimizer::Converged, "iterations = %g", r.run->stats.iterations);
+    }
+
+    // 投机阻尼：第一个阻尼系数被接受的迭代只算一次残差，被拒绝的迭代多一轮 tries - 1 个试探点
+    const LMOptimizer::Statistics& s = speculative.stats;
+    int expected = 1 + s.iterations + s.speculativeRounds * (tries - 1);
+    check("Rosenbrock speculative: batches only after a rejection", s.speculativeRounds > 0 && s.residualEvaluations == expected,
+          "speculative rounds = %g", s.speculativeRounds);
+    check("Rosenbrock geodesic: corrected steps taken, no more iterations", geodesic.stats.geodesicSteps > 0 && geodesic.stats.iterations <= serial.stats.iterations,
+          "iterations = %g", geodesic.stats.iterations);
+    check("Rosenbrock Broyden: fewer Jacobians than serial", broyden.stats.jacobianEvaluations < serial.stats.jacobianEvaluations,
+          "Jacobians = %g", broyden.stats.jacobianEvaluations);
+
+    // 线性问题的每一步都被接受：投机阻尼从不批量计算，迭代路径与逐次试探逐位相同
+    LinearProblem linear;
+    LMOptimizer::Options options;
+    options.initialLambda = 10.0;
+    options.maxIterations = 4;  // 尚未到达极小点，每轮都能下降
+    options.targetMse = 0.0;
+    Vector paths[2];
+    int rounds = 0;
+    for (int mode = 0; mode < 2; ++mode) {
+        options.speculativeDamping = (mode == 1);
+        LMOptimizer optimizer(options);
+        LMOptimizer::Problem p = linear.problem();
+        Vector path(3 * options.maxIterations);
+        int accepted = 0;
+        p.stepAccepted = [&](const Vector& x, double) {
+            if (accepted < options.maxIterations) path.segment(3 * accepted++, 3) = x;
+        };
+        Vector x = Vector::Zero(3);
+        optimizer.minimize(p, x);
+        paths[mode] = path.head(3 * accepted);
+        if (mode == 1) rounds = optimizer.statistics().speculativeRounds;
+    }
+    check("no rejection: speculative path identical to serial", rounds == 0 && paths[0].size() == 3 * options.maxIterations && paths[0] == paths[1],
+          "speculative rounds = %g", rounds);
+}
+
+} // namespace
+
+int main()
+{
+    testKnownMinimum();
+    testSvdSolveMatchesLeastSquares();
+    testBoundActive();
+    testRankDeficient();
+    testBroydenRefresh();
+    testDampingLimit();
+    testCancelAndStop();
+    testDampingModes();
+
+    std::printf("%s: %d failure(s)\n", g_failures ? "FAILED" : "OK", g_failures);
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,27 @@
+# ----------------------------------------------------
+# Project: tst_lmoptimizer
+# Description: LMOptimizer 回归测试 (已知极小点、上下界、秩亏雅可比、Broyden、停止条件、各阻尼模式对比)
+# 运行: qmake && make && ./tst_lmoptimizer，全部通过时返回 0
+# ----------------------------------------------------
+
+TEMPLATE = app
+TARGET = tst_lmoptimizer
+CONFIG += console c++17
+CONFIG -= qt app_bundle
+
+# 与主工程相同的优化选项
+QMAKE_CXXFLAGS += -O3
+QMAKE_CXXFLAGS_RELEASE -= -O2
+QMAKE_CXXFLAGS_RELEASE += -O3
+
+INCLUDEPATH += ../..
+
+# Eigen 矩阵库
+INCLUDEPATH += D:/08YYYXXX/eigen-3.3.8
+
+SOURCES += \
+    ../../lmoptimizer.cpp \
+    tst_lmoptimizer.cpp
+
+HEADERS += \
+    ../../lmoptimizer.h
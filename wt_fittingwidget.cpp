@@ -6,10 +6,32 @@
  * 2. 实现了多线程 Levenberg-Marquardt 拟合算法。
  * 3. 实现了数据的加载及展示。
  * 4. [修复] 解决了滚轮调节参数时曲线颜色变蓝的问题（通过优化 Replot 时机）。
+ * 5. 参数预览与敏感性曲线走求解器的无因次曲线缓存，只改变换算参数 (h、phi、mu、Ct、q、B) 时无需重新反演。
+ * 6. 拟合线程使用自己的低精度求解上下文，不再切换 ModelManager 的全局精度，拟合期间界面预览互不干扰。
+ * 7. 雅可比矩阵的 2N 组扰动参数与敏感性分析的多组参数均一次交给求解器批量计算。
+ * 8. 停止按钮的标志作为取消标志传入拟合上下文，求解器在计算中途即可响应，不必等待本轮迭代结束。
+ * 9. 雅可比矩阵改用求解器前向自动微分给出的精确偏导，一次求解得到全部列；求解器无法给出时退回中心差分。
+ * 10. 可选 Broyden 秩一更新：完整雅可比矩阵之间用试探点残差修正，每隔数轮或进展停滞时才重新完整计算。
+ * 11. LM 迭代交给 LMOptimizer (Eigen 连续存储、缩放雅可比的奇异值分解求阻尼步长)，本类只提供残差与雅可比矩阵；
+ *     迭代变量与参数范围在拟合开始时一次换算到 log10 空间，完成提示中显示迭代统计。
+ * 12. 多起点全局拟合：拉丁超立方起点并发运行 LM (GlobalOptimizer)，共享当前最优并剪枝，结束后选择前 k 个解之一。
+ * 13. 差分进化 / CMA-ES 拟合 (PopulationOptimizer)：每代个体一次交给求解器批量并行计算，可选 LM 精修。
+ * 14. 观测点多于 300 个时，迭代中的理论曲线只在 60~150 个自适应对数时间配点上计算，按双对数 PCHIP 插值到观测时间；
+ *     雅可比矩阵的相对偏导同样在网格上计算后插值。收敛后在全部观测点上核对，插值误差明显时加密网格再精修。
+ * 15. 加载数据时按对数时间分箱抽稀 (DataReduction)：导数在原始数据上计算后与压差一同分箱，
+ *     分箱权重乘到对应残差上；原始序列随状态一起保存。
+ * 16. 迭代中的残差与雅可比矩阵由 FittingWorkspace 计算 (观测对数值、掩码与插值系数预先算好，缓冲区复用)，
+ *     参数直接写入 ModelParams 下标，不再经过 QMap 与名称查找；并发的起点各持有一份工作区。
+ * 17. 拟合中的界面刷新直接显示算残差时的理论曲线，不再每步另算一条默认时间网格上的曲线；
+ *     刷新按固定帧率节流，上一帧界面尚未处理时丢弃本次，拟合结束后的最终曲线照常计算。
+ * 18. 投机阻尼：LM 第一个阻尼系数被拒绝后，其余阻尼系数的试探点一次交给求解器批量并行计算，取最好的；可选测地加速修正步长。
  */
 
 #include "wt_fittingwidget.h"
 #include "ui_wt_fittingwidget.h"
+#include "curveinterpolator.h"
+#include "datareduction.h"
+#include "globaloptimizer.h"
 #include "modelparameter.h"
 #include "modelselect.h"
 #include "fittingdatadialog.h"
@@ -18,8 +40,14 @@
 
 #include <QtConcurrent>
 #include <QMessageBox>
+#include <QInputDialog>
+#include <QMutex>
+#include <QThread>
 #include <QDebug>
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <vector>
 #include <QFileDialog>
 #include <QFile>
 #include <QTextStream>
@@ -83,6 +111,15 @@ FittingWidget::FittingWidget(QWidget *parent) :
     ui->sliderWeight->setRange(0, 100);
     ui->sliderWeight->setValue(50);
     onSliderWeightChanged(50);
+
+    // 多起点只用于 LM，精修只用于种群算法
+    auto updateAlgorithmOptions = [this](int index) {
+        bool lm = (index == FitOptions::LevenbergMarquardt);
+        ui->checkGlobalFit->setEnabled(lm);
+        ui->checkPolish->setEnabled(!lm);
+    };
+    connect(ui->comboAlgorithm, QOverload<int>::of(&QComboBox::currentIndexChanged), this, updateAlgorithmOptions);
+    updateAlgorithmOptions(ui->comboAlgorithm->currentIndex());
 }
 
 FittingWidget::~FittingWidget()
@@ -240,14 +277,35 @@ void FittingWidget::on_btnLoadData_clicked() {
         }
     }
 
-    setObservedData(rawTime, finalDeltaP, finalDeriv);
-    QMessageBox::information(this, "成功", "观测数据已成功加载。");
+    if (!settings.enableReduction) {
+        setObservedData(rawTime, finalDeltaP, finalDeriv);
+        QMessageBox::information(this, "成功", "观测数据已成功加载。");
+        return;
+    }
+
+    // 对数时间分箱抽稀，原始序列另行保留
+    DataReduction::Options reduction;
+    reduction.pointsPerCycle = settings.pointsPerCycle;
+    reduction.method = settings.reductionMethod == 1 ? DataReduction::Mean : DataReduction::Median;
+    DataReduction::Result reduced = DataReduction::reduce(rawTime, finalDeltaP, finalDeriv, reduction);
+
+    setObservedData(reduced.time, reduced.deltaP, reduced.derivative, reduced.weightP, reduced.weightD);
+    m_rawTime = rawTime;
+    m_rawDeltaP = finalDeltaP;
+    m_rawDerivative = finalDeriv;
+    QMessageBox::information(this, "成功", QString("观测数据已成功加载 (原始 %1 点，抽稀后 %2 点)。").arg(rawTime.size()).arg(reduced.time.size()));
 }
 
-void FittingWidget::setObservedData(const QVector<double>& t, const QVector<double>& deltaP, const QVector<double>& d) {
+void FittingWidget::setObservedData(const QVector<double>& t, const QVector<double>& deltaP, const QVector<double>& d,
+                                    const QVector<double>& weightP, const QVector<double>& weightD) {
     m_obsTime = t;
     m_obsDeltaP = deltaP;
     m_obsDerivative = d;
+    m_obsWeightP = weightP;
+    m_obsWeightD = weightD;
+    m_rawTime.clear();
+    m_rawDeltaP.clear();
+    m_rawDerivative.clear();
 
     QVector<double> vt, vp, vd;
     for(int i=0; i<t.size(); ++i) {
@@ -301,14 +359,23 @@ void FittingWidget::on_btnRunFit_clicked() {
     m_paramChart->updateParamsFromTable();
     m_isFitting = true;
     m_stopRequested = false;
+    m_iterationTimer.start();
+    m_lastIterationUpdate = -kIterationUpdateIntervalMs;
+    m_iterationUpdatePending = false;
     ui->btnRunFit->setEnabled(false);
 
     ModelManager::ModelType modelType = m_currentModelType;
     QList<FitParameter> paramsCopy = m_paramChart->getParameters();
     double w = ui->sliderWeight->value() / 100.0;
-
-    m_watcher.setFuture(QtConcurrent::run([this, modelType, paramsCopy, w](){
-        runOptimizationTask(modelType, paramsCopy, w);
+    FitOptions options;
+    options.algorithm = (FitOptions::Algorithm)ui->comboAlgorithm->currentIndex();
+    options.broyden = ui->checkBroyden->isChecked();
+    options.geodesic = ui->checkGeodesic->isChecked();
+    options.globalFit = ui->checkGlobalFit->isChecked();
+    options.polish = ui->checkPolish->isChecked();
+
+    m_watcher.setFuture(QtConcurrent::run([this, modelType, paramsCopy, w, options](){
+        runOptimizationTask(modelType, paramsCopy, w, options);
     }));
 }
 
@@ -464,227 +531,588 @@ void FittingWidget::onExportCurveData() {
     }
 }
 
-void FittingWidget::runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, double weight) {
-    runLevenbergMarquardtOptimization(modelType, fitParams, weight);
+void FittingWidget::runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, double weight, const FitOptions& options) {
+    m_populationStatistics = PopulationOptimizer::Statistics();
+    if(options.algorithm != FitOptions::LevenbergMarquardt) runPopulationOptimization(modelType, fitParams, weight, options);
+    else if(options.globalFit) runGlobalOptimization(modelType, fitParams, weight, options);
+    else runLevenbergMarquardtOptimization(modelType, fitParams, weight, options);
 }
 
-// Levenberg-Marquardt
-void FittingWidget::runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight) {
-    if(m_modelManager) m_modelManager->setHighPrecision(false);
+bool FittingWidget::iterationUpdateDue() {
+    if(m_iterationUpdatePending) return false; // 上一帧还在界面线程的队列中
+    qint64 now = m_iterationTimer.elapsed();
+    qint64 last = m_lastIterationUpdate;
+    if(now - last < kIterationUpdateIntervalMs) return false;
+    if(!m_lastIterationUpdate.compare_exchange_strong(last, now)) return false; // 其他线程已占用本帧
+    m_iterationUpdatePending = true;
+    return true;
+}
 
-    QVector<int> fitIndices;
+bool FittingWidget::prepareFit(ModelManager::ModelType modelType, const QList<FitParameter>& params, double weight, FitSetup& setup) {
+    setup.modelType = modelType;
+    setup.params = params;
+    setup.weight = weight;
+    setup.fitIndices.clear();
     for(int i=0; i<params.size(); ++i) {
-        if(params[i].isFit && params[i].name != "LfD") fitIndices.append(i);
+        if(params[i].isFit && params[i].name != "LfD") setup.fitIndices.append(i);
+    }
+    int nParams = setup.fitIndices.size();
+    if(nParams == 0) return false;
+
+    setup.baseMap.clear();
+    for(const auto& p : params) setup.baseMap.insert(p.name, p.value);
+
+    if(setup.baseMap.contains("L") && setup.baseMap.contains("Lf") && setup.baseMap["L"] > 1e-9)
+        setup.baseMap["LfD"] = setup.baseMap["Lf"] / setup.baseMap["L"];
+
+    // 迭代变量: 正值参数 (S、nf 除外) 取 log10，其余取原值；参数范围同样变换到迭代空间
+    const double inf = std::numeric_limits<double>::infinity();
+    setup.isLog.resize(nParams);
+    setup.x0.resize(nParams);
+    setup.lower.resize(nParams);
+    setup.upper.resize(nParams);
+    setup.sampleLower.resize(nParams);
+    setup.sampleUpper.resize(nParams);
+    for(int i=0; i<nParams; ++i) {
+        const FitParameter& p = params[setup.fitIndices[i]];
+        double val = setup.baseMap[p.name];
+        setup.isLog[i] = (val > 1e-12 && p.name != "S" && p.name != "nf");
+        if(setup.isLog[i]) {
+            setup.x0(i) = log10(val);
+            setup.lower(i) = p.min > 0.0 ? log10(p.min) : -inf;
+            setup.upper(i) = log10(qMax(p.max, 1e-300));
+        } else {
+            setup.x0(i) = val;
+            setup.lower(i) = p.min;
+            setup.upper(i) = p.max;
+        }
+        setup.sampleLower(i) = std::isfinite(setup.lower(i)) ? setup.lower(i) : setup.x0(i) - 3.0;
+        setup.sampleUpper(i) = std::isfinite(setup.upper(i)) ? setup.upper(i) : setup.x0(i) + 3.0;
     }
-    int nParams = fitIndices.size();
 
-    if(nParams == 0) {
-        QMetaObject::invokeMethod(this, "onFitFinished");
-        return;
+    // 求解器参数下标与偏导列 (迭代中不再按名称查找)
+    setup.baseParams = ModelParams::fromMap(setup.baseMap);
+    setup.fitKeys.resize(nParams);
+    setup.sensitivityKeys.clear();
+    setup.sensitivityColumns.clear();
+    for(int i=0; i<nParams; ++i) {
+        int key = ModelParams::indexOf(params[setup.fitIndices[i]].name);
+        setup.fitKeys[i] = key;
+        if(key < 0) continue;
+        setup.sensitivityKeys.append(ModelParams::Index(key));
+        setup.sensitivityColumns.append(i);
     }
 
-    double lambda = 0.01;
-    int maxIter = 50;
-    double currentSSE = 1e15;
+    // 观测部分 (对数值、掩码、权重系数) 只准备一次
+    setup.grid.clear();
+    setup.workspace.setObservations(m_obsTime, m_obsDeltaP, m_obsDerivative, m_obsWeightP, m_obsWeightD, weight);
+    return true;
+}
 
-    QMap<QString, double> currentParamMap;
-    for(const auto& p : params) currentParamMap.insert(p.name, p.value);
+QMap<QString, double> FittingWidget::paramsAt(const FitSetup& setup, const LMOptimizer::Vector& x) {
+    QMap<QString, double> map = setup.baseMap;
+    for(int i=0; i<setup.fitIndices.size(); ++i)
+        map[setup.params[setup.fitIndices[i]].name] = setup.isLog[i] ? pow(10.0, x(i)) : x(i);
+    if(map.contains("L") && map.contains("Lf") && map["L"] > 1e-9)
+        map["LfD"] = map["Lf"] / map["L"];
+    return map;
+}
 
-    if(currentParamMap.contains("L") && currentParamMap.contains("Lf") && currentParamMap["L"] > 1e-9)
-        currentParamMap["LfD"] = currentParamMap["Lf"] / currentParamMap["L"];
+ModelParams FittingWidget::modelParamsAt(const FitSetup& setup, const LMOptimizer::Vector& x) {
+    ModelParams params = setup.baseParams;
+    for(int i=0; i<setup.fitKeys.size(); ++i) {
+        if(setup.fitKeys[i] >= 0)
+            params.set(ModelParams::Index(setup.fitKeys[i]), setup.isLog[i] ? pow(10.0, x(i)) : x(i));
+    }
+    params.updateLfD();
+    return params;
+}
 
-    QVector<double> residuals = calculateResiduals(currentParamMap, modelType, weight);
-    currentSSE = calculateSumSquaredError(residuals);
+LMOptimizer::Problem FittingWidget::makeFitProblem(const FitSetup& setup, const SolverContext* context, FittingWorkspace* workspace) {
+    LMOptimizer::Problem problem;
+    problem.lower = setup.lower;
+    problem.upper = setup.upper;
+    problem.residuals = [this, &setup, context, workspace](const LMOptimizer::Vector& v, LMOptimizer::Vector& r) {
+        ModelCurveData curve = m_modelManager->calculateTheoreticalCurve(setup.modelType, modelParamsAt(setup, v), workspace->fitTimes(), *context);
+        if(m_stopRequested) return false; // 曲线未算完
+        if(!workspace->residuals(curve, r)) r.resize(0); // 长度不符，按失败的试探步处理
+        return true;
+    };
+    problem.jacobian = [this, &setup, context, workspace](const LMOptimizer::Vector& v, const LMOptimizer::Vector&, LMOptimizer::Matrix& J) {
+        computeJacobian(setup, modelParamsAt(setup, v), *context, *workspace, J);
+        return !m_stopRequested; // 计算被中断，雅可比矩阵不完整
+    };
+    return problem;
+}
 
-    ModelCurveData curve = m_modelManager->calculateTheoreticalCurve(modelType, currentParamMap);
-    emit sigIterationUpdated(currentSSE/residuals.size(), currentParamMap, std::get<0>(curve), std::get<1>(curve), std::get<2>(curve));
+void FittingWidget::runLocalRefinement(const FitSetup& setup, const SolverContext& context, const FitOptions& fitOptions, LMOptimizer::Vector& x, LMOptimizer::Statistics& stats) {
+    const int maxIter = 50;
+    LMOptimizer::Options options;
+    options.maxIterations = maxIter;
+    options.broydenUpdate = fitOptions.broyden;
+    options.geodesicAcceleration = fitOptions.geodesic;
+    // 求解器可在线程池中展开时，第一个阻尼系数被拒绝后其余的一次批量计算 (被接受的迭代不多算模型)
+    options.speculativeDamping = context.parallel;
+    LMOptimizer optimizer(options);
+
+    FittingWorkspace workspace = setup.workspace;
+    LMOptimizer::Problem problem = makeFitProblem(setup, &context, &workspace);
+
+    // 本轮试探点中残差最小者的理论曲线 (隐式共享，不复制数据)。被接受的点总是本轮残差最小的试探点，
+    // 但不一定是最近一次算残差的点 (如测地加速在接受之后还会再算一个修正试探点)
+    LMOptimizer::Vector bestX;
+    ModelCurveData bestCurve;
+    double bestSse = std::numeric_limits<double>::infinity();
+    auto keepIfBest = [&](const LMOptimizer::Vector& v, const LMOptimizer::Vector& r, const ModelCurveData& curve) {
+        if(r.size() == 0 || !(r.squaredNorm() < bestSse)) return;
+        bestSse = r.squaredNorm();
+        bestX = v;
+        bestCurve = curve;
+    };
+    LMOptimizer::ResidualFunction residuals = problem.residuals;
+    problem.residuals = [&](const LMOptimizer::Vector& v, LMOptimizer::Vector& r) {
+        if(!residuals(v, r)) return false;
+        keepIfBest(v, r, workspace.lastCurve());
+        return true;
+    };
+
+    // 投机阻尼：被拒绝后其余的试探点一次交给求解器批量计算 (求解器内部按参数组并行)
+    QVector<ModelParams> batchParams;
+    QVector<ModelCurveData> batchCurves;
+    LMOptimizer::Vector batchR;
+    problem.batchResiduals = [&](const LMOptimizer::Matrix& X, LMOptimizer::Matrix& R) {
+        batchParams.resize(int(X.cols()));
+        for(int k=0; k<X.cols(); ++k)
+            batchParams[k] = modelParamsAt(setup, LMOptimizer::Vector(X.col(k)));
+        batchCurves = m_modelManager->calculateTheoreticalCurves(setup.modelType, batchParams, workspace.fitTimes(), context);
+        if(m_stopRequested || batchCurves.size() != batchParams.size()) return false;
+        for(int k=0; k<X.cols(); ++k) {
+            if(workspace.residuals(batchCurves[k], batchR)) {
+                R.col(k) = batchR;
+                keepIfBest(X.col(k), batchR, batchCurves[k]);
+            } else {
+                R.col(k).setConstant(std::numeric_limits<double>::quiet_NaN());
+            }
+        }
+        return true;
+    };
+
+    // 起点与刚接受的点都已算过残差，直接显示该次的理论曲线 (配点网格或观测时间上)，不再另算
+    auto report = [&](const LMOptimizer::Vector& v, double sse) {
+        if(m_stopRequested || bestX.size() != v.size() || bestX != v || !iterationUpdateDue()) return;
+        emit sigIterationUpdated(sse/optimizer.residuals().size(), paramsAt(setup, v), std::get<0>(bestCurve), std::get<1>(bestCurve), std::get<2>(bestCurve));
+    };
+    problem.iterationStarted = [&](int iter, double sse) {
+        if(iter == 0) report(x, sse); // 初始曲线
+        bestSse = std::numeric_limits<double>::infinity(); // 本轮的试探点重新比较
+        emit sigProgress(iter * 100 / maxIter);
+    };
+    problem.stepAccepted = report;
 
-    for(int iter = 0; iter < maxIter; ++iter) {
-        if(m_stopRequested) break;
-        if (!residuals.isEmpty() && (currentSSE / residuals.size()) < 3e-3) break;
+    optimizer.minimize(problem, x);
+    stats = optimizer.statistics();
+}
 
-        emit sigProgress(iter * 100 / maxIter);
+// Levenberg-Marquardt
+void FittingWidget::runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight, const FitOptions& fitOptions) {
+    // 拟合迭代使用低精度上下文 (线程私有的缓冲区)，最终曲线按默认配置计算
+    SolverWorkspace fitWorkspace;
+    SolverContext fitContext;
+    if(m_modelManager) fitContext.settings = m_modelManager->solverSettings(modelType);
+    fitContext.settings.highPrecision = false;
+    fitContext.workspace = &fitWorkspace;
+    fitContext.cancel = &m_stopRequested;
+
+    m_fitStatistics = LMOptimizer::Statistics();
+    m_fitGridSize = 0;
+
+    FitSetup setup;
+    if(!prepareFit(modelType, params, weight, setup) || !m_modelManager) {
+        QMetaObject::invokeMethod(this, "onFitFinished");
+        return;
+    }
+    buildCollocationGrid(setup, setup.baseMap, fitContext, 2e-3);
 
-        QVector<QVector<double>> J = computeJacobian(currentParamMap, residuals, fitIndices, modelType, params, weight);
-        int nRes = residuals.size();
+    LMOptimizer::Vector x = setup.x0;
+    runLocalRefinement(setup, fitContext, fitOptions, x, m_fitStatistics);
+    if(m_fitStatistics.stopReason == LMOptimizer::Cancelled && m_fitStatistics.residualEvaluations == 0) {
+        // 初始残差未算完即被停止，参数保持不变
+        QMetaObject::invokeMethod(this, "onFitFinished");
+        return;
+    }
 
-        QVector<QVector<double>> H(nParams, QVector<double>(nParams, 0.0));
-        QVector<double> g(nParams, 0.0);
+    // 配点网格上收敛后在全部观测点上核对
+    double currentSSE = verifyOnObservations(setup, fitContext, fitOptions, true, x, m_fitStatistics.finalSse);
+    m_fitGridSize = setup.grid.size();
+    QMap<QString, double> currentParamMap = paramsAt(setup, x);
 
-        for(int k=0; k<nRes; ++k) {
-            for(int i=0; i<nParams; ++i) {
-                g[i] += J[k][i] * residuals[k];
-                for(int j=0; j<=i; ++j) {
-                    H[i][j] += J[k][i] * J[k][j];
-                }
-            }
+    ModelCurveData finalCurve = m_modelManager->calculateTheoreticalCurve(modelType, currentParamMap);
+    emit sigIterationUpdated(currentSSE/qMax(1, observationResidualCount()), currentParamMap, std::get<0>(finalCurve), std::get<1>(finalCurve), std::get<2>(finalCurve));
+
+    QMetaObject::invokeMethod(this, "onFitFinished");
+}
+
+// 多起点全局拟合
+void FittingWidget::runGlobalOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight, const FitOptions& fitOptions) {
+    m_fitStatistics = LMOptimizer::Statistics();
+    m_globalSolutions.clear();
+    m_fitGridSize = 0;
+
+    FitSetup setup;
+    if(!prepareFit(modelType, params, weight, setup) || !m_modelManager) {
+        QMetaObject::invokeMethod(this, "onFitFinished");
+        return;
+    }
+    int nParams = setup.fitIndices.size();
+
+    // 起点之间已经并行，各起点的求解不再展开到计算线程池
+    SolverContext baseContext;
+    baseContext.settings = m_modelManager->solverSettings(modelType);
+    baseContext.settings.highPrecision = false;
+    baseContext.parallel = false;
+    baseContext.cancel = &m_stopRequested;
+
+    // 配点网格与最终核对在所有起点之外计算，可使用计算线程池
+    SolverContext checkContext = baseContext;
+    checkContext.parallel = true;
+    buildCollocationGrid(setup, setup.baseMap, checkContext, 2e-3);
+
+    GlobalOptimizer::Options options;
+    options.starts = qMax(8, 2 * QThread::idealThreadCount());
+    options.local.broydenUpdate = fitOptions.broyden;
+    options.local.geodesicAcceleration = fitOptions.geodesic;
+    GlobalOptimizer global(options);
+
+    // 每个起点持有自己的缓冲区、上下文与残差工作区
+    std::vector<SolverWorkspace> workspaces(options.starts);
+    std::vector<SolverContext> contexts(options.starts, baseContext);
+    std::vector<FittingWorkspace> fitWorkspaces(options.starts, setup.workspace);
+    for(int s=0; s<options.starts; ++s) contexts[s].workspace = &workspaces[s];
+
+    auto factory = [&](int start) { return makeFitProblem(setup, &contexts[start], &fitWorkspaces[start]); };
+
+    int expectedResiduals = qMax(1, observationResidualCount());
+
+    QMutex reportMutex;
+    double reportedSse = std::numeric_limits<double>::infinity();
+    auto progress = [&](int finished, int total, const LMOptimizer::Vector& bestX, double bestSse) {
+        emit sigProgress(finished * 100 / total);
+        {
+            QMutexLocker locker(&reportMutex);
+            if(!(bestSse < reportedSse) || !iterationUpdateDue()) return;
+            reportedSse = bestSse;
         }
+        // 当前最优解有改进且到了刷新时刻时，在拟合时间上算一条显示曲线 (临时缓冲区，可在任意线程计算)
+        QMap<QString, double> map = paramsAt(setup, bestX);
+        ModelCurveData curve = m_modelManager->calculateTheoreticalCurve(modelType, modelParamsAt(setup, bestX), setup.workspace.fitTimes(), baseContext);
+        if(!m_stopRequested)
+            emit sigIterationUpdated(bestSse / expectedResiduals, map, std::get<0>(curve), std::get<1>(curve), std::get<2>(curve));
+    };
+
+    QVector<GlobalOptimizer::Solution> solutions = global.minimize(factory, setup.x0, setup.sampleLower, setup.sampleUpper, progress,
+                                                                   [this]() { return bool(m_stopRequested); });
+    m_fitStatistics = global.totalStatistics();
+    if(solutions.isEmpty()) {
+        QMetaObject::invokeMethod(this, "onFitFinished");
+        return;
+    }
+
+    // 供分析人员选择的前 k 个解 (onFitFinished 中弹出)；使用配点网格时按全部观测点上的残差重新排序
+    for(GlobalOptimizer::Solution& solution : solutions)
+        solution.sse = verifyOnObservations(setup, checkContext, fitOptions, false, solution.x, solution.sse);
+    std::stable_sort(solutions.begin(), solutions.end(), [](const GlobalOptimizer::Solution& a, const GlobalOptimizer::Solution& b) { return a.sse < b.sse; });
+    m_fitGridSize = setup.grid.size();
+
+    for(const GlobalOptimizer::Solution& solution : solutions) {
+        GlobalFitSolution item;
+        item.mse = solution.sse / expectedResiduals;
+        item.params = paramsAt(setup, solution.x);
+        QStringList parts;
         for(int i=0; i<nParams; ++i) {
-            for(int j=i+1; j<nParams; ++j) {
-                H[i][j] = H[j][i];
-            }
+            const QString& name = setup.params[setup.fitIndices[i]].name;
+            parts << QString("%1=%2").arg(name).arg(item.params[name], 0, 'g', 4);
         }
+        item.summary = parts.join(", ");
+        m_globalSolutions.append(item);
+    }
+    m_globalModelType = modelType;
+    m_globalPrunedStarts = global.prunedStarts();
+    m_globalStarts = options.starts;
 
-        bool stepAccepted = false;
-        for(int tryIter=0; tryIter<5; ++tryIter) {
-            QVector<QVector<double>> H_lm = H;
-            for(int i=0; i<nParams; ++i) {
-                H_lm[i][i] += lambda * (1.0 + std::abs(H[i][i]));
-            }
-
-            QVector<double> negG(nParams);
-            for(int i=0;i<nParams;++i) negG[i] = -g[i];
-
-            QVector<double> delta = solveLinearSystem(H_lm, negG);
-            QMap<QString, double> trialMap = currentParamMap;
+    const GlobalFitSolution& best = m_globalSolutions.first();
+    ModelCurveData finalCurve = m_modelManager->calculateTheoreticalCurve(modelType, best.params);
+    emit sigIterationUpdated(best.mse, best.params, std::get<0>(finalCurve), std::get<1>(finalCurve), std::get<2>(finalCurve));
 
-            for(int i=0; i<nParams; ++i) {
-                int pIdx = fitIndices[i];
-                QString pName = params[pIdx].name;
-                double oldVal = currentParamMap[pName];
-                bool isLog = (oldVal > 1e-12 && pName != "S" && pName != "nf");
-                double newVal;
+    QMetaObject::invokeMethod(this, "onFitFinished");
+}
 
-                if(isLog) newVal = pow(10.0, log10(oldVal) + delta[i]);
-                else newVal = oldVal + delta[i];
+// 差分进化 / CMA-ES (每代批量计算)，可选 LM 精修
+void FittingWidget::runPopulationOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight, const FitOptions& fitOptions) {
+    SolverWorkspace fitWorkspace;
+    SolverContext fitContext;
+    if(m_modelManager) fitContext.settings = m_modelManager->solverSettings(modelType);
+    fitContext.settings.highPrecision = false;
+    fitContext.workspace = &fitWorkspace;
+    fitContext.cancel = &m_stopRequested;
 
-                newVal = qMax(params[pIdx].min, qMin(newVal, params[pIdx].max));
-                trialMap[pName] = newVal;
-            }
+    m_fitStatistics = LMOptimizer::Statistics();
+    m_fitGridSize = 0;
 
-            if(trialMap.contains("L") && trialMap.contains("Lf") && trialMap["L"] > 1e-9)
-                trialMap["LfD"] = trialMap["Lf"] / trialMap["L"];
-
-            QVector<double> newRes = calculateResiduals(trialMap, modelType, weight);
-            double newSSE = calculateSumSquaredError(newRes);
-
-            if(newSSE < currentSSE) {
-                currentSSE = newSSE;
-                currentParamMap = trialMap;
-                residuals = newRes;
-                lambda /= 10.0;
-                stepAccepted = true;
-                ModelCurveData iterCurve = m_modelManager->calculateTheoreticalCurve(modelType, currentParamMap);
-                emit sigIterationUpdated(currentSSE/nRes, currentParamMap, std::get<0>(iterCurve), std::get<1>(iterCurve), std::get<2>(iterCurve));
-                break;
-            } else {
-                lambda *= 10.0;
+    FitSetup setup;
+    if(!prepareFit(modelType, params, weight, setup) || !m_modelManager) {
+        QMetaObject::invokeMethod(this, "onFitFinished");
+        return;
+    }
+    buildCollocationGrid(setup, setup.baseMap, fitContext, 2e-3);
+    FittingWorkspace workspace = setup.workspace;
+
+    int expectedResiduals = qMax(1, observationResidualCount());
+
+    PopulationOptimizer::Options options;
+    options.method = (fitOptions.algorithm == FitOptions::CmaEs) ? PopulationOptimizer::CmaEs : PopulationOptimizer::DifferentialEvolution;
+    options.targetSse = 3e-3 * expectedResiduals;   // 与 LM 的收敛判据 (MSE < 3e-3) 一致
+    PopulationOptimizer optimizer(options);
+
+    // 一代的全部个体一次交给求解器批量计算 (求解器内部按参数组并行)；
+    // 记下已算个体中最优者的曲线，界面刷新直接显示
+    ModelCurveData bestCurve;
+    double bestCurveSse = std::numeric_limits<double>::infinity();
+    auto objective = [&](const PopulationOptimizer::Matrix& population, PopulationOptimizer::Vector& sse) {
+        QVector<ModelParams> list;
+        list.reserve(int(population.rows()));
+        for(int k=0; k<population.rows(); ++k)
+            list.append(modelParamsAt(setup, LMOptimizer::Vector(population.row(k).transpose())));
+        QVector<ModelCurveData> curves = m_modelManager->calculateTheoreticalCurves(modelType, list, workspace.fitTimes(), fitContext);
+        if(m_stopRequested || curves.size() != list.size()) return false;
+        for(int k=0; k<list.size(); ++k) {
+            sse(k) = workspace.sumSquares(curves[k]);
+            if(sse(k) < bestCurveSse) {
+                bestCurveSse = sse(k);
+                bestCurve = curves[k];
             }
         }
-        if(!stepAccepted && lambda > 1e10) break;
+        return true;
+    };
+
+    double reportedSse = std::numeric_limits<double>::infinity();
+    auto generationDone = [&](int generation, const PopulationOptimizer::Vector& bestX, double bestSse) {
+        emit sigProgress(qMin(100, generation * 100 / qMax(1, options.maxGenerations)));
+        if(bestSse < reportedSse && !m_stopRequested && iterationUpdateDue()) {
+            reportedSse = bestSse;
+            emit sigIterationUpdated(bestSse / expectedResiduals, paramsAt(setup, bestX), std::get<0>(bestCurve), std::get<1>(bestCurve), std::get<2>(bestCurve));
+        }
+        return !m_stopRequested;
+    };
+
+    LMOptimizer::Vector x = setup.x0;
+    optimizer.minimize(objective, x, setup.sampleLower, setup.sampleUpper, generationDone);
+    m_populationStatistics = optimizer.statistics();
+    if(m_populationStatistics.evaluations == 0) {
+        // 第一代未算完即被停止，参数保持不变
+        QMetaObject::invokeMethod(this, "onFitFinished");
+        return;
     }
+    double currentSSE = m_populationStatistics.bestSse;
+
+    // LM 精修：从种群最优个体出发，使用精确雅可比矩阵
+    if(fitOptions.polish && !m_stopRequested && currentSSE >= options.targetSse) {
+        LMOptimizer::Vector refined = x;
+        runLocalRefinement(setup, fitContext, fitOptions, refined, m_fitStatistics);
+        if(m_fitStatistics.residualEvaluations > 0 && m_fitStatistics.finalSse <= currentSSE) {
+            x = refined;
+            currentSSE = m_fitStatistics.finalSse;
+        }
+    }
+    currentSSE = verifyOnObservations(setup, fitContext, fitOptions, fitOptions.polish, x, currentSSE);
+    m_fitGridSize = setup.grid.size();
 
-    if(m_modelManager) m_modelManager->setHighPrecision(true);
-
-    if(currentParamMap.contains("L") && currentParamMap.contains("Lf") && currentParamMap["L"] > 1e-9)
-        currentParamMap["LfD"] = currentParamMap["Lf"] / currentParamMap["L"];
-
+    QMap<QString, double> currentParamMap = paramsAt(setup, x);
     ModelCurveData finalCurve = m_modelManager->calculateTheoreticalCurve(modelType, currentParamMap);
-    emit sigIterationUpdated(currentSSE/residuals.size(), currentParamMap, std::get<0>(finalCurve), std::get<1>(finalCurve), std::get<2>(finalCurve));
+    emit sigIterationUpdated(currentSSE / expectedResiduals, currentParamMap, std::get<0>(finalCurve), std::get<1>(finalCurve), std::get<2>(finalCurve));
 
     QMetaObject::invokeMethod(this, "onFitFinished");
 }
 
-QVector<double> FittingWidget::calculateResiduals(const QMap<QString, double>& params, ModelManager::ModelType modelType, double weight) {
-    if(!m_modelManager || m_obsTime.isEmpty()) return QVector<double>();
-
-    ModelCurveData res = m_modelManager->calculateTheoreticalCurve(modelType, params, m_obsTime);
-    const QVector<double>& pCal = std::get<1>(res);
-    const QVector<double>& dpCal = std::get<2>(res);
-
-    QVector<double> r;
-    double wp = weight;
-    double wd = 1.0 - weight;
+double FittingWidget::observationSse(FittingWorkspace& workspace, ModelManager::ModelType modelType, const ModelParams& params, const SolverContext& context) {
+    if(!m_modelManager || workspace.fitTimes().isEmpty()) return std::numeric_limits<double>::infinity();
+    return workspace.sumSquares(m_modelManager->calculateTheoreticalCurve(modelType, params, workspace.fitTimes(), context));
+}
 
-    int count = qMin(m_obsDeltaP.size(), pCal.size());
-    for(int i=0; i<count; ++i) {
-        if(m_obsDeltaP[i] > 1e-10 && pCal[i] > 1e-10)
-            r.append( (log(m_obsDeltaP[i]) - log(pCal[i])) * wp );
-        else
-            r.append(0.0);
+void FittingWidget::computeJacobian(const FitSetup& setup, const ModelParams& base, const SolverContext& context, FittingWorkspace& workspace, Eigen::MatrixXd& J) {
+    J.setZero();
+    if(!m_modelManager || m_obsTime.isEmpty() || setup.sensitivityKeys.isEmpty()) return;
+
+    // 1. 求解器一次给出理论曲线及其对各拟合参数的精确偏导 (使用配点网格时在网格上计算)
+    const QVector<ModelParams::Index>& keys = setup.sensitivityKeys;
+    ModelCurveSensitivity sens = m_modelManager->calculateSensitivities(setup.modelType, base, keys, workspace.fitTimes(), context);
+    if(sens.dP.size() != keys.size()) {
+        // 被取消时直接返回 (调用者检查停止标志)，其余情况退回差分
+        if(m_stopRequested) return;
+        computeJacobianByDifferences(setup, base, context, workspace, J);
+        return;
     }
 
-    int dCount = qMin(m_obsDerivative.size(), dpCal.size());
-    dCount = qMin(dCount, count);
-    for(int i=0; i<dCount; ++i) {
-        if(m_obsDerivative[i] > 1e-10 && dpCal[i] > 1e-10)
-            r.append( (log(m_obsDerivative[i]) - log(dpCal[i])) * wd );
-        else
-            r.append(0.0);
+    // 2. 残差 r = (ln obs - ln cal) * w，故 dr/dθ = -w * (dcal/dθ) / cal，被屏蔽的残差偏导为 0；
+    //    对数参数的迭代变量为 log10(θ)，列再乘 dθ/dlog10(θ) = θ * ln10。
+    //    使用配点网格时，相对偏导 (dcal/dθ) / cal 在网格上计算后按对数时间插值到观测点
+    if(!workspace.beginJacobian(sens.curve)) return;
+    for(int k = 0; k < keys.size(); ++k) {
+        int j = setup.sensitivityColumns[k];
+        double chain = setup.isLog[j] ? base.value(keys[k]) * std::log(10.0) : 1.0;
+        workspace.jacobianColumn(sens.dP[k], sens.dDeriv[k], chain, j, J);
     }
-    return r;
 }
 
-QVector<QVector<double>> FittingWidget::computeJacobian(const QMap<QString, double>& params, const QVector<double>& baseResiduals, const QVector<int>& fitIndices, ModelManager::ModelType modelType, const QList<FitParameter>& currentFitParams, double weight) {
-    int nRes = baseResiduals.size();
-    int nParams = fitIndices.size();
-    QVector<QVector<double>> J(nRes, QVector<double>(nParams));
+void FittingWidget::computeJacobianByDifferences(const FitSetup& setup, const ModelParams& base, const SolverContext& context, FittingWorkspace& workspace, Eigen::MatrixXd& J) {
+    int nRes = int(J.rows());
+    const QVector<ModelParams::Index>& keys = setup.sensitivityKeys;
 
-    for(int j = 0; j < nParams; ++j) {
-        int idx = fitIndices[j];
-        QString pName = currentFitParams[idx].name;
-        double val = params.value(pName);
-        bool isLog = (val > 1e-12 && pName != "S" && pName != "nf");
+    // 1. 组装所有扰动参数: 第 k 个有效列对应 perturbed[2k] (正向) 与 perturbed[2k+1] (反向)
+    QVector<ModelParams> perturbed;
+    QVector<double> steps;
+    perturbed.reserve(2 * keys.size());
+
+    for(int k = 0; k < keys.size(); ++k) {
+        ModelParams::Index key = keys[k];
+        double val = base.value(key);
 
         double h;
-        QMap<QString, double> pPlus = params;
-        QMap<QString, double> pMinus = params;
+        ModelParams pPlus = base;
+        ModelParams pMinus = base;
 
-        if(isLog) {
+        if(setup.isLog[setup.sensitivityColumns[k]]) {
             h = 0.01;
             double valLog = log10(val);
-            pPlus[pName] = pow(10.0, valLog + h);
-            pMinus[pName] = pow(10.0, valLog - h);
+            pPlus.set(key, pow(10.0, valLog + h));
+            pMinus.set(key, pow(10.0, valLog - h));
         } else {
             h = 1e-4;
-            pPlus[pName] = val + h;
-            pMinus[pName] = val - h;
+            pPlus.set(key, val + h);
+            pMinus.set(key, val - h);
         }
 
-        auto updateDeps = [](QMap<QString,double>& map) {
-            if(map.contains("L") && map.contains("Lf") && map["L"] > 1e-9)
-                map["LfD"] = map["Lf"] / map["L"];
-        };
+        if(key == ModelParams::L || key == ModelParams::Lf) { pPlus.updateLfD(); pMinus.updateLfD(); }
 
-        if(pName == "L" || pName == "Lf") { updateDeps(pPlus); updateDeps(pMinus); }
+        perturbed.append(pPlus);
+        perturbed.append(pMinus);
+        steps.append(h);
+    }
 
-        QVector<double> rPlus = calculateResiduals(pPlus, modelType, weight);
-        QVector<double> rMinus = calculateResiduals(pMinus, modelType, weight);
+    // 2. 一次批量计算全部扰动曲线 (求解器内部按参数组并行)
+    QVector<ModelCurveData> curves = m_modelManager->calculateTheoreticalCurves(setup.modelType, perturbed, workspace.fitTimes(), context);
+    if(curves.size() != perturbed.size()) return;
 
-        if(rPlus.size() == nRes && rMinus.size() == nRes) {
-            for(int i=0; i<nRes; ++i) {
-                J[i][j] = (rPlus[i] - rMinus[i]) / (2.0 * h);
-            }
+    // 3. 中心差分
+    Eigen::VectorXd rPlus, rMinus;
+    for(int k = 0; k < keys.size(); ++k) {
+        if(workspace.residuals(curves[2 * k], rPlus) && workspace.residuals(curves[2 * k + 1], rMinus) && rPlus.size() == nRes) {
+            J.col(setup.sensitivityColumns[k]) = (rPlus - rMinus) / (2.0 * steps[k]);
         }
     }
-    return J;
 }
 
-QVector<double> FittingWidget::solveLinearSystem(const QVector<QVector<double>>& A, const QVector<double>& b) {
-    int n = b.size();
-    if (n == 0) return QVector<double>();
-
-    Eigen::MatrixXd matA(n, n);
-    Eigen::VectorXd vecB(n);
+int FittingWidget::observationResidualCount() const {
+    int count = qMin(m_obsDeltaP.size(), m_obsTime.size());
+    return count + qMin(m_obsDerivative.size(), count);
+}
 
-    for (int i = 0; i < n; ++i) {
-        vecB(i) = b[i];
-        for (int j = 0; j < n; ++j) {
-            matA(i, j) = A[i][j];
+void FittingWidget::buildCollocationGrid(FitSetup& setup, const QMap<QString, double>& params, const SolverContext& context, double tolerance) {
+    const int kMinPoints = 60;
+    const int kMaxPoints = 150;
+    setup.grid.clear();
+    setup.workspace.setGrid(QVector<double>());
+
+    // 观测点不多时直接在观测时间上计算
+    int n = m_obsTime.size();
+    if(n <= 2 * kMaxPoints || !m_modelManager) return;
+    double tMin = m_obsTime.first();
+    double tMax = m_obsTime.first();
+    for(int i=1; i<n; ++i) {
+        if(!(m_obsTime[i] > m_obsTime[i - 1])) return; // 时间须严格递增且为正 (双对数插值)
+        tMax = m_obsTime[i];
+    }
+    if(!(tMin > 0.0) || !(tMax > tMin)) return;
+
+    // 1. 对数均匀的初始网格
+    QVector<double> logT(kMinPoints);
+    double a = std::log(tMin);
+    double b = std::log(tMax);
+    for(int i=0; i<kMinPoints; ++i) logT[i] = a + (b - a) * i / (kMinPoints - 1);
+
+    // 2. 逐轮在区间对数中点处比较插值与实际值，误差最大的区间优先加密，总点数不超过 kMaxPoints
+    ModelParams mp = ModelParams::fromMap(params);
+    for(int round = 0; round < 4 && logT.size() < kMaxPoints; ++round) {
+        // 网格点与区间中点交错排列，一次求解
+        int m = logT.size();
+        QVector<double> all(2 * m - 1), t(m), mid(m - 1);
+        for(int i=0; i<m; ++i) all[2 * i] = t[i] = std::exp(logT[i]);
+        for(int i=0; i+1<m; ++i) all[2 * i + 1] = mid[i] = std::exp(0.5 * (logT[i] + logT[i + 1]));
+
+        ModelCurveData curve = m_modelManager->calculateTheoreticalCurve(setup.modelType, mp, all, context);
+        const QVector<double>& pAll = std::get<1>(curve);
+        const QVector<double>& dAll = std::get<2>(curve);
+        if(m_stopRequested || pAll.size() != all.size() || dAll.size() != all.size()) break;
+
+        QVector<double> pNode(m), dNode(m);
+        for(int i=0; i<m; ++i) { pNode[i] = pAll[2 * i]; dNode[i] = dAll[2 * i]; }
+        QVector<double> pInterp = CurveInterpolator::pchipLogLog(t, pNode, mid);
+        QVector<double> dInterp = CurveInterpolator::pchipLogLog(t, dNode, mid);
+        QVector<QPair<double, int>> errors;
+        for(int i=0; i<mid.size(); ++i) {
+            double pTrue = pAll[2 * i + 1];
+            double dTrue = dAll[2 * i + 1];
+            double ep = pTrue > 1e-10 ? std::abs(pInterp[i] - pTrue) / pTrue : 0.0;
+            double ed = dTrue > 1e-10 ? std::abs(dInterp[i] - dTrue) / dTrue : 0.0;
+            double e = qMax(ep, ed);
+            if(e > tolerance) errors.append(qMakePair(e, i));
         }
+        if(errors.isEmpty()) break;
+
+        std::sort(errors.begin(), errors.end(), [](const QPair<double, int>& x, const QPair<double, int>& y) { return x.first > y.first; });
+        int room = kMaxPoints - logT.size();
+        QVector<double> inserted;
+        for(int k=0; k<errors.size() && k<room; ++k) inserted.append(std::log(mid[errors[k].second]));
+        logT += inserted;
+        std::sort(logT.begin(), logT.end());
     }
 
-    Eigen::VectorXd x = matA.ldlt().solve(vecB);
-
-    QVector<double> res(n);
-    for (int i = 0; i < n; ++i) res[i] = x(i);
-    return res;
+    setup.grid.resize(logT.size());
+    for(int i=0; i<logT.size(); ++i) setup.grid[i] = std::exp(logT[i]);
+    setup.grid.first() = tMin;
+    setup.grid.last() = tMax;
+    setup.workspace.setGrid(setup.grid);
 }
 
-double FittingWidget::calculateSumSquaredError(const QVector<double>& residuals) {
-    double sse = 0.0;
-    for(double v : residuals) sse += v*v;
-    return sse;
+double FittingWidget::verifyOnObservations(FitSetup& setup, const SolverContext& context, const FitOptions& fitOptions, bool refine, LMOptimizer::Vector& x, double gridSse) {
+    if(setup.grid.isEmpty() || m_stopRequested) return gridSse;
+
+    // 与迭代共用同一套残差规则，只是不带网格
+    FittingWorkspace full = setup.workspace;
+    full.setGrid(QVector<double>());
+    double fullSse = observationSse(full, setup.modelType, modelParamsAt(setup, x), context);
+    if(m_stopRequested || !std::isfinite(fullSse)) return gridSse;
+
+    // 插值误差使残差平方和偏差超过 5% 时，在当前参数处重建更密的网格并再精修一次
+    if(refine && std::abs(fullSse - gridSse) > 0.05 * fullSse) {
+        buildCollocationGrid(setup, paramsAt(setup, x), context, 2.5e-4);
+        LMOptimizer::Vector refined = x;
+        LMOptimizer::Statistics stats;
+        runLocalRefinement(setup, context, fitOptions, refined, stats);
+        m_fitStatistics.iterations += stats.iterations;
+        m_fitStatistics.residualEvaluations += stats.residualEvaluations;
+        m_fitStatistics.jacobianEvaluations += stats.jacobianEvaluations;
+        m_fitStatistics.broydenUpdates += stats.broydenUpdates;
+        m_fitStatistics.rejectedSteps += stats.rejectedSteps;
+        m_fitStatistics.speculativeRounds += stats.speculativeRounds;
+        m_fitStatistics.geodesicSteps += stats.geodesicSteps;
+
+        double checkSse = observationSse(full, setup.modelType, modelParamsAt(setup, refined), context);
+        if(!m_stopRequested && checkSse < fullSse) {
+            x = refined;
+            fullSse = checkSse;
+        }
+    }
+    return fullSse;
 }
 
 QVector<double> FittingWidget::parseSensitivityValues(const QString& text) {
@@ -750,16 +1178,26 @@ void FittingWidget::updateModelCurve() {
     QList<QColor> colors = { Qt::red, Qt::blue, QColor(0,180,0), Qt::magenta, QColor(255,140,0), Qt::cyan, Qt::darkRed, Qt::darkBlue };
 
     if (isSensitivityMode) {
+        QVector<ModelParams> paramsList;
+        paramsList.reserve(sensitivityValues.size());
         for(int i = 0; i < sensitivityValues.size(); ++i) {
-            double val = sensitivityValues[i];
             QMap<QString, double> currentParams = baseParams;
-            currentParams[sensitivityKey] = val;
+            currentParams[sensitivityKey] = sensitivityValues[i];
 
             if (sensitivityKey == "L" || sensitivityKey == "Lf") {
                 if(currentParams["L"] > 1e-9) currentParams["LfD"] = currentParams["Lf"] / currentParams["L"];
             }
+            paramsList.append(ModelParams::fromMap(currentParams));
+        }
 
-            ModelCurveData res = m_modelManager->calculateTheoreticalCurve(type, currentParams, targetT);
+        // 各敏感性取值一次批量计算 (预览配置: 走无因次曲线缓存)
+        SolverContext previewContext;
+        previewContext.settings = m_modelManager->previewSettings(type);
+        QVector<ModelCurveData> curves = m_modelManager->calculateTheoreticalCurves(type, paramsList, targetT, previewContext);
+
+        for(int i = 0; i < curves.size(); ++i) {
+            double val = sensitivityValues[i];
+            const ModelCurveData& res = curves[i];
 
             QColor c = colors[i % colors.size()];
             QString legendSuffix = QString("%1=%2").arg(sensitivityKey).arg(val);
@@ -777,7 +1215,7 @@ void FittingWidget::updateModelCurve() {
         // [修复] 敏感性分析循环结束后统一刷新
         m_plot->replot();
     } else {
-        ModelCurveData res = m_modelManager->calculateTheoreticalCurve(type, baseParams, targetT);
+        ModelCurveData res = m_modelManager->calculatePreviewCurve(type, baseParams, targetT);
 
         plotCurves(std::get<0>(res), std::get<1>(res), std::get<2>(res), true);
 
@@ -790,9 +1228,13 @@ void FittingWidget::updateModelCurve() {
         }
 
         if (!m_obsTime.isEmpty()) {
-            QVector<double> residuals = calculateResiduals(baseParams, type, ui->sliderWeight->value()/100.0);
-            double sse = calculateSumSquaredError(residuals);
-            ui->label_Error->setText(QString("误差(MSE): %1").arg(sse/residuals.size(), 0, 'e', 3));
+            SolverContext context;
+            context.settings = m_modelManager->solverSettings(type);
+            FittingWorkspace workspace;
+            workspace.setObservations(m_obsTime, m_obsDeltaP, m_obsDerivative, m_obsWeightP, m_obsWeightD, ui->sliderWeight->value()/100.0);
+            double sse = observationSse(workspace, type, ModelParams::fromMap(baseParams), context);
+            if(std::isfinite(sse))
+                ui->label_Error->setText(QString("误差(MSE): %1").arg(sse/qMax(1, workspace.residualCount()), 0, 'e', 3));
         }
         // [修复] 单曲线模式设置颜色后统一刷新，解决颜色错乱问题
         m_plot->replot();
@@ -801,6 +1243,7 @@ void FittingWidget::updateModelCurve() {
 
 void FittingWidget::onIterationUpdate(double err, const QMap<QString,double>& p,
                                       const QVector<double>& t, const QVector<double>& p_curve, const QVector<double>& d_curve) {
+    m_iterationUpdatePending = false;
     ui->label_Error->setText(QString("误差(MSE): %1").arg(err, 0, 'e', 3));
 
     ui->tableParams->blockSignals(true);
@@ -830,7 +1273,41 @@ void FittingWidget::onIterationUpdate(double err, const QMap<QString,double>& p,
 void FittingWidget::onFitFinished() {
     m_isFitting = false;
     ui->btnRunFit->setEnabled(true);
-    QMessageBox::information(this, "完成", "拟合完成。");
+    QString text = "拟合完成。";
+    const LMOptimizer::Statistics& stats = m_fitStatistics;
+    if(stats.iterations > 0) {
+        text += QString("\n迭代 %1 次，残差计算 %2 次，雅可比矩阵完整计算 %3 次").arg(stats.iterations).arg(stats.residualEvaluations).arg(stats.jacobianEvaluations);
+        if(stats.broydenUpdates > 0) text += QString("，Broyden 修正 %1 次").arg(stats.broydenUpdates);
+        if(stats.speculativeRounds > 0) text += QString("，阻尼试探批量计算 %1 轮").arg(stats.speculativeRounds);
+        if(stats.geodesicSteps > 0) text += QString("，测地加速 %1 步").arg(stats.geodesicSteps);
+        text += "。";
+    }
+    const PopulationOptimizer::Statistics& population = m_populationStatistics;
+    if(population.evaluations > 0)
+        text += QString("\n种群算法: %1 代，模型计算 %2 次。").arg(population.generations).arg(population.evaluations);
+    if(m_fitGridSize > 0)
+        text += QString("\n在 %1 个对数时间配点上拟合 (观测点 %2 个)，结果已在全部观测点上核对。").arg(m_fitGridSize).arg(m_obsTime.size());
+
+    // 全局拟合: 从前 k 个解中选择 (默认的最优解已显示在界面上)
+    QVector<GlobalFitSolution> solutions;
+    solutions.swap(m_globalSolutions);
+    if(solutions.size() > 1) {
+        QStringList items;
+        for(int i=0; i<solutions.size(); ++i)
+            items << QString("#%1  MSE=%2  %3").arg(i + 1).arg(solutions[i].mse, 0, 'e', 3).arg(solutions[i].summary);
+        text += QString("\n起点 %1 个，提前终止 %2 个。请选择要采用的解：").arg(m_globalStarts).arg(m_globalPrunedStarts);
+
+        bool ok = false;
+        QString chosen = QInputDialog::getItem(this, "全局拟合结果", text, items, 0, false, &ok);
+        int index = items.indexOf(chosen);
+        if(ok && index > 0 && m_modelManager) {
+            const GlobalFitSolution& s = solutions[index];
+            ModelCurveData curve = m_modelManager->calculateTheoreticalCurve(m_globalModelType, s.params);
+            onIterationUpdate(s.mse, s.params, std::get<0>(curve), std::get<1>(curve), std::get<2>(curve));
+        }
+        return;
+    }
+    QMessageBox::information(this, "完成", text);
 }
 
 void FittingWidget::plotCurves(const QVector<double>& t, const QVector<double>& p, const QVector<double>& d, bool isModel) {
@@ -896,6 +1373,11 @@ QJsonObject FittingWidget::getJsonState() const
     root["modelType"] = (int)m_currentModelType;
     root["modelName"] = ModelManager::getModelTypeName(m_currentModelType);
     root["fitWeightVal"] = ui->sliderWeight->value();
+    root["fitBroyden"] = ui->checkBroyden->isChecked();
+    root["fitGeodesic"] = ui->checkGeodesic->isChecked();
+    root["fitGlobal"] = ui->checkGlobalFit->isChecked();
+    root["fitAlgorithm"] = ui->comboAlgorithm->currentIndex();
+    root["fitPolish"] = ui->checkPolish->isChecked();
 
     QJsonObject plotRange;
     plotRange["xMin"] = m_plot->xAxis->range().lower;
@@ -926,8 +1408,27 @@ QJsonObject FittingWidget::getJsonState() const
     obsData["time"] = timeArr;
     obsData["pressure"] = pressArr;
     obsData["derivative"] = derivArr;
+    if(!m_obsWeightP.isEmpty() || !m_obsWeightD.isEmpty()) {
+        QJsonArray wpArr, wdArr;
+        for(double v : m_obsWeightP) wpArr.append(v);
+        for(double v : m_obsWeightD) wdArr.append(v);
+        obsData["weightP"] = wpArr;
+        obsData["weightD"] = wdArr;
+    }
     root["observedData"] = obsData;
 
+    if(!m_rawTime.isEmpty()) {
+        QJsonArray rawT, rawP, rawD;
+        for(double v : m_rawTime) rawT.append(v);
+        for(double v : m_rawDeltaP) rawP.append(v);
+        for(double v : m_rawDerivative) rawD.append(v);
+        QJsonObject rawData;
+        rawData["time"] = rawT;
+        rawData["pressure"] = rawP;
+        rawData["derivative"] = rawD;
+        root["rawObservedData"] = rawData;
+    }
+
     return root;
 }
 
@@ -976,6 +1477,11 @@ void FittingWidget::loadFittingState(const QJsonObject& root)
         int val = root["fitWeightVal"].toInt();
         ui->sliderWeight->setValue(val);
     }
+    if (root.contains("fitBroyden")) ui->checkBroyden->setChecked(root["fitBroyden"].toBool());
+    if (root.contains("fitGeodesic")) ui->checkGeodesic->setChecked(root["fitGeodesic"].toBool());
+    if (root.contains("fitGlobal")) ui->checkGlobalFit->setChecked(root["fitGlobal"].toBool());
+    if (root.contains("fitAlgorithm")) ui->comboAlgorithm->setCurrentIndex(root["fitAlgorithm"].toInt());
+    if (root.contains("fitPolish")) ui->checkPolish->setChecked(root["fitPolish"].toBool());
 
     if (root.contains("observedData")) {
         QJsonObject obs = root["observedData"].toObject();
@@ -983,12 +1489,21 @@ void FittingWidget::loadFittingState(const QJsonObject& root)
         QJsonArray pArr = obs["pressure"].toArray();
         QJsonArray dArr = obs["derivative"].toArray();
 
-        QVector<double> t, p, d;
+        QVector<double> t, p, d, wp, wd;
         for(auto v : tArr) t.append(v.toDouble());
         for(auto v : pArr) p.append(v.toDouble());
         for(auto v : dArr) d.append(v.toDouble());
+        for(auto v : obs["weightP"].toArray()) wp.append(v.toDouble());
+        for(auto v : obs["weightD"].toArray()) wd.append(v.toDouble());
+
+        setObservedData(t, p, d, wp, wd);
+    }
 
-        setObservedData(t, p, d);
+    if (root.contains("rawObservedData")) {
+        QJsonObject raw = root["rawObservedData"].toObject();
+        for(auto v : raw["time"].toArray()) m_rawTime.append(v.toDouble());
+        for(auto v : raw["pressure"].toArray()) m_rawDeltaP.append(v.toDouble());
+        for(auto v : raw["derivative"].toArray()) m_rawDerivative.append(v.toDouble());
     }
 
     updateModelCurve();
@@ -3,10 +3,17 @@
  * 文件作用: 试井拟合分析主界面类的头文件
  * 功能描述:
  * 1. 定义拟合分析界面的主要控件成员变量和布局逻辑。
- * 2. 声明用于Levenberg-Marquardt非线性回归拟合的核心算法函数。
+ * 2. 声明用于Levenberg-Marquardt非线性回归拟合的核心算法函数 (迭代由 LMOptimizer 完成，本类提供残差与雅可比矩阵)。
  * 3. 声明观测数据（时间、压差、导数）的管理函数。
  * 4. 支持多文件数据源加载。
  * 5. 支持参数敏感性分析（多值输入绘制多条曲线）。
+ * 6. 支持多起点全局拟合，结束后由分析人员从前 k 个解中选择。
+ * 7. 支持差分进化、CMA-ES 无导数拟合 (每代批量计算)，可选 LM 精修。
+ * 8. 观测点较多时在自适应对数时间配点网格上拟合，残差由双对数插值得到，收敛后在全部观测点上核对。
+ * 9. 加载数据时可按对数时间分箱抽稀，保留原始与抽稀后两套序列，分箱给出的权重进入残差。
+ * 10. 残差与雅可比矩阵由 FittingWorkspace 计算：观测部分在拟合开始时准备一次，迭代中只复用缓冲区。
+ * 11. 拟合中的界面刷新复用算残差时的理论曲线，并按固定帧率节流。
+ * 12. LM 步长被拒绝后，其余阻尼系数一次批量并行计算 (投机阻尼)，可选测地加速。
  */
 
 #ifndef WT_FITTINGWIDGET_H
@@ -16,9 +23,14 @@
 #include <QMap>
 #include <QVector>
 #include <QFutureWatcher>
+#include <QElapsedTimer>
+#include <atomic>
 #include <QJsonObject>
 #include <QStandardItemModel>
 #include "modelmanager.h"
+#include "lmoptimizer.h"
+#include "populationoptimizer.h"
+#include "fittingworkspace.h"
 #include "mousezoom.h"
 #include "chartwidget.h"
 #include "fittingparameterchart.h"
@@ -40,8 +52,9 @@ public:
     // 设置项目数据模型集合 (支持多文件)
     void setProjectDataModels(const QMap<QString, QStandardItemModel*>& models);
 
-    // 设置观测数据
-    void setObservedData(const QVector<double>& t, const QVector<double>& deltaP, const QVector<double>& deriv);
+    // 设置观测数据 (参与拟合的序列)；weightP/weightD 为各点残差权重，为空时均为 1
+    void setObservedData(const QVector<double>& t, const QVector<double>& deltaP, const QVector<double>& deriv,
+                         const QVector<double>& weightP = QVector<double>(), const QVector<double>& weightD = QVector<double>());
 
     // 更新基础参数
     void updateBasicParameters();
@@ -112,11 +125,37 @@ private:
     QVector<double> m_obsTime;
     QVector<double> m_obsDeltaP;
     QVector<double> m_obsDerivative;
+    QVector<double> m_obsWeightP;       // 压差残差权重 (抽稀时由箱内离散程度给出，为空表示均为 1)
+    QVector<double> m_obsWeightD;       // 导数残差权重
+    // 抽稀前的原始序列 (未抽稀时为空)
+    QVector<double> m_rawTime;
+    QVector<double> m_rawDeltaP;
+    QVector<double> m_rawDerivative;
+
+    // 全局拟合返回的候选解
+    struct GlobalFitSolution {
+        double mse = 0.0;
+        QMap<QString, double> params;
+        QString summary;                    // 拟合参数取值摘要 (供选择对话框显示)
+    };
 
     // 拟合状态控制
     bool m_isFitting;
-    bool m_stopRequested;
+    std::atomic_bool m_stopRequested{false};   // 拟合线程的求解上下文直接引用此标志，停止后正在进行的曲线计算随即中断
     QFutureWatcher<void> m_watcher;
+    LMOptimizer::Statistics m_fitStatistics;   // 最近一次拟合的迭代统计 (拟合线程写入，结束后界面读取)
+    PopulationOptimizer::Statistics m_populationStatistics;    // 最近一次种群算法拟合的统计
+    QVector<GlobalFitSolution> m_globalSolutions;  // 最近一次全局拟合的前 k 个解 (按 MSE 升序)
+    ModelManager::ModelType m_globalModelType = ModelManager::Model_1;
+    int m_globalStarts = 0;
+    int m_globalPrunedStarts = 0;
+    int m_fitGridSize = 0;                     // 最近一次拟合的配点数 (0 表示直接在观测时间上计算)
+
+    // 拟合中的界面刷新节流 (拟合线程判断，界面线程清除待处理标志)
+    static const int kIterationUpdateIntervalMs = 50;  // 最多每秒 20 帧
+    QElapsedTimer m_iterationTimer;
+    std::atomic<qint64> m_lastIterationUpdate{0};
+    std::atomic_bool m_iterationUpdatePending{false};
 
     // 初始化图表设置
     void setupPlot();
@@ -127,21 +166,74 @@ private:
     // 更新模型曲线（包含敏感性分析逻辑及 LfD 自动计算）
     void updateModelCurve();
 
-    // 核心拟合算法函数 (Levenberg-Marquardt)
-    void runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, double weight);
-    void runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight);
-
-    // 计算残差
-    QVector<double> calculateResiduals(const QMap<QString, double>& params, ModelManager::ModelType modelType, double weight);
-
-    // 计算雅可比矩阵
-    QVector<QVector<double>> computeJacobian(const QMap<QString, double>& params, const QVector<double>& residuals, const QVector<int>& fitIndices, ModelManager::ModelType modelType, const QList<FitParameter>& currentFitParams, double weight);
-
-    // 求解线性方程组
-    QVector<double> solveLinearSystem(const QVector<QVector<double>>& A, const QVector<double>& b);
-
-    // 计算平方误差和
-    double calculateSumSquaredError(const QVector<double>& residuals);
+    // 一次拟合中迭代变量与界面参数的对应关系
+    struct FitSetup {
+        ModelManager::ModelType modelType;
+        QList<FitParameter> params;
+        QVector<int> fitIndices;            // params 中参与拟合的下标
+        QVector<bool> isLog;                // 迭代变量是否为 log10(参数)
+        QMap<QString, double> baseMap;      // 拟合开始时的全部参数 (含不参与拟合的参数)
+        ModelParams baseParams;             // 同上 (定长数组形式，迭代中复制后改写拟合参数)
+        QVector<int> fitKeys;               // 第 i 个迭代变量的 ModelParams 下标 (未知参数名为 -1)
+        QVector<ModelParams::Index> sensitivityKeys; // 需要求偏导的参数
+        QVector<int> sensitivityColumns;    // 对应的雅可比矩阵列
+        double weight = 0.5;
+        LMOptimizer::Vector x0;             // 初始迭代变量
+        LMOptimizer::Vector lower;          // 迭代空间中的参数范围
+        LMOptimizer::Vector upper;
+        LMOptimizer::Vector sampleLower;    // 采样/搜索范围 (对数参数下限未给出时取初值以下三个数量级)
+        LMOptimizer::Vector sampleUpper;
+        QVector<double> grid;               // 配点时间 (为空时直接在观测时间上计算)
+        FittingWorkspace workspace;         // 已准备好观测部分与网格的工作区 (各线程复制后使用)
+    };
+
+    // 拟合算法与选项 (界面选择)
+    struct FitOptions {
+        enum Algorithm { LevenbergMarquardt = 0, DifferentialEvolution, CmaEs };
+        Algorithm algorithm = LevenbergMarquardt;
+        bool broyden = false;               // LM: Broyden 秩一修正雅可比矩阵
+        bool geodesic = false;              // LM: 测地加速修正步长
+        bool globalFit = false;             // LM: 多起点全局拟合
+        bool polish = true;                 // 种群算法结束后用 LM 精修
+    };
+
+    // 核心拟合算法函数 (Levenberg-Marquardt、多起点 LM、差分进化/CMA-ES)
+    void runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, double weight, const FitOptions& options);
+    void runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight, const FitOptions& fitOptions);
+    void runGlobalOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight, const FitOptions& fitOptions);
+    void runPopulationOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight, const FitOptions& options);
+    // 从 x 出发的 LM 迭代，接受步长时刷新界面；返回后 x 为结果。context 可并行时一轮的阻尼试探批量计算
+    void runLocalRefinement(const FitSetup& setup, const SolverContext& context, const FitOptions& fitOptions, LMOptimizer::Vector& x, LMOptimizer::Statistics& stats);
+
+    // 是否发出本次迭代刷新：距上次不足一帧或上一帧界面尚未处理时返回 false (丢弃本次，可在任意线程调用)
+    bool iterationUpdateDue();
+
+    // 由界面参数建立迭代变量；没有参与拟合的参数时返回 false
+    bool prepareFit(ModelManager::ModelType modelType, const QList<FitParameter>& params, double weight, FitSetup& setup);
+    // 迭代变量对应的全部参数 (含 LfD 同步)
+    static QMap<QString, double> paramsAt(const FitSetup& setup, const LMOptimizer::Vector& x);
+    // 同上，直接给出求解器参数 (迭代中使用，不经过 QMap)
+    static ModelParams modelParamsAt(const FitSetup& setup, const LMOptimizer::Vector& x);
+    // 残差与雅可比回调 (setup、context 与 workspace 须在优化期间有效)
+    LMOptimizer::Problem makeFitProblem(const FitSetup& setup, const SolverContext* context, FittingWorkspace* workspace);
+
+    // 在 workspace 的计算时间上算理论曲线并返回残差平方和 (不带网格的工作区即全部观测点)；
+    // 求解精度与缓冲区由 context 指定，计算被取消时为 +inf
+    double observationSse(FittingWorkspace& workspace, ModelManager::ModelType modelType, const ModelParams& params, const SolverContext& context);
+
+    // 计算雅可比矩阵，写入已分配好的 J (残差数 × 拟合参数数)；setup.isLog[j] 表示第 j 列的迭代变量为 log10(参数)。
+    // 使用求解器给出的精确偏导，不可用时退回中心差分
+    void computeJacobian(const FitSetup& setup, const ModelParams& base, const SolverContext& context, FittingWorkspace& workspace, Eigen::MatrixXd& J);
+    // 中心差分雅可比矩阵 (2N 组扰动参数一次批量计算)
+    void computeJacobianByDifferences(const FitSetup& setup, const ModelParams& base, const SolverContext& context, FittingWorkspace& workspace, Eigen::MatrixXd& J);
+
+    // 全部观测点对应的残差个数
+    int observationResidualCount() const;
+    // 观测点较多时在 params 处建立自适应对数时间配点网格：从 60 个对数均匀点开始，
+    // 在插值相对误差超过 tolerance 的区间中点处加密 (最多 150 点)；观测点不多时清空网格
+    void buildCollocationGrid(FitSetup& setup, const QMap<QString, double>& params, const SolverContext& context, double tolerance);
+    // 在全部观测点上核对 x 处的残差平方和并返回；与网格上的值相差超过 5% 且 refine 时加密网格再精修一次 (变好才采用)
+    double verifyOnObservations(FitSetup& setup, const SolverContext& context, const FitOptions& fitOptions, bool refine, LMOptimizer::Vector& x, double gridSse);
 
     // 辅助绘图函数
     QString getPlotImageBase64();
@@ -6,6 +6,7 @@
  * 2. 响应用户操作，收集界面参数，调用 ModelSolver01_06 进行计算。
  * 3. 将计算结果绘制在 QCustomPlot 图表上。
  * 4. [逻辑] 实现了 LfD 随 L 和 Lf 变化的自动计算逻辑。
+ * 5. 敏感性分析的多组参数一次交给 Solver 批量计算，再依次绘制。
  */
 
 #include "wt_modelwidget.h"
@@ -68,12 +69,25 @@ WT_ModelWidget::ModelCurveData WT_ModelWidget::calculateTheoreticalCurve(const Q
     return ModelCurveData();
 }
 
+QVector<WT_ModelWidget::ModelCurveData> WT_ModelWidget::calculateTheoreticalCurves(const QVector<ModelParams>& paramsList, const QVector<double>& providedTime)
+{
+    if (m_solver) {
+        return m_solver->calculateTheoreticalCurves(paramsList, providedTime);
+    }
+    return QVector<ModelCurveData>(paramsList.size());
+}
+
 void WT_ModelWidget::setHighPrecision(bool high)
 {
     m_highPrecision = high;
     if (m_solver) m_solver->setHighPrecision(high);
 }
 
+void WT_ModelWidget::setSolverSettings(const SolverSettings& settings)
+{
+    if (m_solver) m_solver->setSolverSettings(settings);
+}
+
 void WT_ModelWidget::initUi() {
     using MT = ModelSolver01_06::ModelType;
     if (m_type == MT::Model_1 || m_type == MT::Model_2) {
@@ -314,22 +328,29 @@ void WT_ModelWidget::runCalculation() {
     QString resultTextHeader = QString("计算完成 (%1)\n").arg(getModelName());
     if(isSensitivity) resultTextHeader += QString("敏感性参数: %1\n").arg(sensitivityKey);
 
-    // 循环计算曲线
+    // 组装各条曲线的参数
+    QVector<ModelParams> paramsList;
+    paramsList.reserve(iterations);
     for(int i = 0; i < iterations; ++i) {
         QMap<QString, double> currentParams = baseParams;
-        double val = 0;
         if (isSensitivity) {
-            val = sensitivityValues[i];
-            currentParams[sensitivityKey] = val;
+            currentParams[sensitivityKey] = sensitivityValues[i];
 
             // [逻辑] 敏感性分析中若 L 或 Lf 变化，也需联动 LfD
             if (sensitivityKey == "L" || sensitivityKey == "Lf") {
                 if(currentParams["L"] > 1e-9) currentParams["LfD"] = currentParams["Lf"] / currentParams["L"];
             }
         }
+        paramsList.append(ModelParams::fromMap(currentParams));
+    }
 
-        // 调用 Solver 计算
-        ModelCurveData res = calculateTheoreticalCurve(currentParams, t);
+    // 调用 Solver 批量计算
+    QVector<ModelCurveData> results = calculateTheoreticalCurves(paramsList, t);
+
+    // 依次绘制曲线
+    for(int i = 0; i < iterations; ++i) {
+        const ModelCurveData& res = results[i];
+        double val = isSensitivity ? sensitivityValues[i] : 0.0;
 
         // 缓存最后一次结果用于显示
         res_tD = std::get<0>(res);
@@ -38,9 +38,15 @@ public:
     // 设置高精度模式（转发给 Solver）
     void setHighPrecision(bool high);
 
+    // 设置求解配置（转发给 Solver）
+    void setSolverSettings(const SolverSettings& settings);
+
     // 直接调用求解器计算（供外部管理器使用，非 UI 交互）
     ModelCurveData calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>());
 
+    // 批量计算多组参数（转发给 Solver，结果顺序与输入一致）
+    QVector<ModelCurveData> calculateTheoreticalCurves(const QVector<ModelParams>& paramsList, const QVector<double>& providedTime = QVector<double>());
+
     // 获取当前模型名称
     QString getModelName() const;
 